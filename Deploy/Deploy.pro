@@ -41,11 +41,11 @@ CONFIG(release, debug|release): {
 }
 
 include('$$PWD/../QuasarAppLib/QuasarLib.pri')
-include('$$PWD/../pe/pe-parser-library/pe-parser-library.pri')
 include('$$PWD/../zip/zip.pri')
 
 
 SOURCES += \
+    ahocorasick.cpp \
     Distributions/deb.cpp \
     Distributions/defaultdistro.cpp \
     Distributions/templateinfo.cpp \
@@ -55,8 +55,10 @@ SOURCES += \
     distromodule.cpp \
     distrostruct.cpp \
     configparser.cpp \
+    copybackend.cpp \
     deploy.cpp \
     deploycore.cpp \
+    deploymanifest.cpp \
     elf_type.cpp \
     envirement.cpp \
     extra.cpp \
@@ -66,23 +68,31 @@ SOURCES += \
     generalfiles_type.cpp \
     ignorerule.cpp \
     metafilemanager.cpp \
+    miniz.c \
     packagecontrol.cpp \
     packing.cpp \
+    parallel.cpp \
     pathutils.cpp \
     igetlibinfo.cpp \
     dependenciesscanner.cpp \
-    ../qtTools/src/shared/winutils/elfreader.cpp \
     pe_type.cpp \
     pluginsparser.cpp \
     Distributions/qif.cpp \
     qml.cpp \
+    ldcache.cpp \
+    libgraph.cpp \
     libinfo.cpp \
+    libinfocache.cpp \
+    libpriorityclassifier.cpp \
     qtdir.cpp \
     targetdata.cpp \
     targetinfo.cpp \
-    zipcompresser.cpp
+    uringcopier.cpp \
+    zipcompresser.cpp \
+    zipwriter.cpp
 
 HEADERS += \
+    ahocorasick.h \
     Distributions/deb.h \
     Distributions/defaultdistro.h \
     Distributions/templateinfo.h \
@@ -93,9 +103,11 @@ HEADERS += \
     distromodule.h \
     distrostruct.h \
     configparser.h \
+    copybackend.h \
     deploy.h \
     deploy_global.h \
     deploycore.h \
+    deploymanifest.h \
     elf_type.h \
     envirement.h \
     extra.h \
@@ -107,19 +119,25 @@ HEADERS += \
     metafilemanager.h \
     packagecontrol.h \
     packing.h \
+    parallel.h \
     pathutils.h \
     igetlibinfo.h \
     dependenciesscanner.h \
-    ../qtTools/src/shared/winutils/elfreader.h \
     pe_type.h \
     pluginsparser.h \
     Distributions/qif.h \
     qml.h \
+    ldcache.h \
+    libgraph.h \
     libinfo.h \
+    libinfocache.h \
+    libpriorityclassifier.h \
     qtdir.h \
     targetdata.h \
     targetinfo.h \
-    zipcompresser.h
+    uringcopier.h \
+    zipcompresser.h \
+    zipwriter.h
 
 STATECHARTS +=
 
@@ -43,7 +43,7 @@ bool Deb::deployTemplate(PackageControl &pkg) {
         auto local = location(package);
         auto localData = dataLocation(package);
 
-        if (!pkg.movePackage(*it, localData)) {
+        if (!pkg.linkPackage(*it, localData)) {
             return false;
         }
 
@@ -7,6 +7,7 @@
 #include <QProcess>
 #include <QHash>
 #include <QFileInfo>
+#include <functional>
 
 class FileManager;
 class DistroModule;
@@ -16,6 +17,13 @@ class DeployConfig;
 struct SystemCommandData {
     QString command;
     QStringList arguments;
+
+    /**
+     * @brief function This is job that invoked instead of the command process (for example compressing of the zip arhive).
+     *  The command and the arguments are used only for the log. The job can be invoked on the worker thread, so it must be thread-safe.
+     *  The argument of the job is count of the threads that the job can use, the jobs option is shared between all running jobs.
+     */
+    std::function<bool(int jobs)> function;
 };
 
 class DEPLOYSHARED_EXPORT iDistribution
@@ -237,7 +237,7 @@ bool QIF::deployPackage(const DistroModule& dist,
         return false;
     }
 
-    if (!pkg.movePackage(dist.key(), localData)) {
+    if (!pkg.linkPackage(dist.key(), localData)) {
         return false;
     }
 
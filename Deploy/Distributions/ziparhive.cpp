@@ -18,8 +18,6 @@ bool ZipArhive::deployTemplate(PackageControl &pkg) {
     // default template
     const DeployConfig *cfg = DeployCore::_config;
 
-    ZipCompresser zipWorker;
-
     auto list = pkg.availablePackages();
     for (auto it = list.begin();
          it != list.end(); ++it) {
@@ -34,15 +32,22 @@ bool ZipArhive::deployTemplate(PackageControl &pkg) {
         auto local = location(package);
         auto dataLoc = dataLocation(package);
 
-        if (!pkg.movePackage(*it, dataLoc)) {
+        if (!pkg.linkPackage(*it, dataLoc)) {
             return false;
         }
 
         auto arr = cfg->getTargetDir() + "/" + info.Name + ".zip";
-        if (!zipWorker.compress(local, arr)) {
-                return false;
-        }
 
+        SystemCommandData compress;
+        compress.command = "compress";
+        compress.arguments = QStringList{local, arr};
+        const int level = cfg->zipLevel;
+        compress.function = [local, arr, level](int jobs) {
+            ZipCompresser zipWorker;
+            return zipWorker.compress(local, arr, level, jobs);
+        };
+
+        compressJobs.push_back(compress);
         outFiles.push_back(arr);
     }
 
@@ -66,7 +71,7 @@ QProcessEnvironment ZipArhive::processEnvirement() const {
 }
 
 QList<SystemCommandData> ZipArhive::runCmd() {
-    return {};
+    return compressJobs;
 }
 
 QStringList ZipArhive::outPutFiles() const {
@@ -25,6 +25,8 @@ protected:
     QString location(const DistroModule &module) const override;
 private:
     QStringList outFiles;
+    /// compressing of the packages, it is invoked by the Packing class with other commands.
+    QList<SystemCommandData> compressJobs;
 
 
 };
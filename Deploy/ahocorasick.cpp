@@ -0,0 +1,150 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "ahocorasick.h"
+
+#include <QQueue>
+#include <algorithm>
+
+AhoCorasick::AhoCorasick(Qt::CaseSensitivity caseSensitivity):
+    _caseSensitivity(caseSensitivity) {
+    clear();
+}
+
+void AhoCorasick::addPattern(const QString &pattern, int id) {
+    _builded = false;
+
+    if (pattern.isEmpty()) {
+        _emptyPatterns.push_back(id);
+        return;
+    }
+
+    int state = 0;
+    for (const QChar &symbol : pattern) {
+        const ushort key = fold(symbol);
+        int next = _nodes.at(state).next.value(key, -1);
+
+        if (next < 0) {
+            next = _nodes.size();
+            _nodes[state].next.insert(key, next);
+            _nodes.push_back({});
+        }
+
+        state = next;
+    }
+
+    _nodes[state].output.push_back(id);
+}
+
+void AhoCorasick::build() {
+    QQueue<int> queue;
+
+    for (auto it = _nodes[0].next.cbegin(); it != _nodes[0].next.cend(); ++it) {
+        _nodes[it.value()].fail = 0;
+        queue.enqueue(it.value());
+    }
+
+    // breadth-first order guarantees that the failure links of shorter prefixes are ready.
+    while (!queue.isEmpty()) {
+        const int state = queue.dequeue();
+        const auto next = _nodes.at(state).next;
+
+        for (auto it = next.cbegin(); it != next.cend(); ++it) {
+            const int child = it.value();
+            int fail = _nodes.at(state).fail;
+
+            while (fail && !_nodes.at(fail).next.contains(it.key())) {
+                fail = _nodes.at(fail).fail;
+            }
+
+            const int target = _nodes.at(fail).next.value(it.key(), 0);
+            _nodes[child].fail = (target == child)? 0: target;
+            _nodes[child].output += _nodes.at(_nodes.at(child).fail).output;
+
+            queue.enqueue(child);
+        }
+    }
+
+    _builded = true;
+}
+
+ushort AhoCorasick::fold(QChar symbol) const {
+    if (_caseSensitivity == Qt::CaseInsensitive) {
+        return symbol.toCaseFolded().unicode();
+    }
+
+    return symbol.unicode();
+}
+
+int AhoCorasick::step(int state, ushort symbol) const {
+    while (true) {
+        const int next = _nodes.at(state).next.value(symbol, -1);
+        if (next >= 0) {
+            return next;
+        }
+
+        if (!state) {
+            return 0;
+        }
+
+        state = _nodes.at(state).fail;
+    }
+}
+
+template<typename Callback>
+void AhoCorasick::search(const QString &text, Callback callback) const {
+    Q_ASSERT_X(_builded, "AhoCorasick::search", "The automaton is not built");
+
+    for (int id : _emptyPatterns) {
+        callback(id);
+    }
+
+    int state = 0;
+    for (const QChar &symbol : text) {
+        state = step(state, fold(symbol));
+
+        for (int id : _nodes.at(state).output) {
+            callback(id);
+        }
+    }
+}
+
+QVector<int> AhoCorasick::matches(const QString &text) const {
+    QVector<int> result;
+
+    search(text, [&result](int id) {
+        result.push_back(id);
+    });
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
+int AhoCorasick::firstMatch(const QString &text) const {
+    int result = -1;
+
+    search(text, [&result](int id) {
+        if (result < 0 || id < result) {
+            result = id;
+        }
+    });
+
+    return result;
+}
+
+bool AhoCorasick::isEmpty() const {
+    return _nodes.size() <= 1 && _emptyPatterns.isEmpty();
+}
+
+void AhoCorasick::clear() {
+    _nodes.clear();
+    _nodes.push_back({});
+    _emptyPatterns.clear();
+    _builded = false;
+}
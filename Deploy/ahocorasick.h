@@ -0,0 +1,74 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef AHOCORASICK_H
+#define AHOCORASICK_H
+
+#include "deploy_global.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The AhoCorasick class is matcher of the many substrings.
+ * All patterns are compiled into one automaton, so the text is scanned only once for all patterns.
+ */
+class DEPLOYSHARED_EXPORT AhoCorasick
+{
+public:
+    AhoCorasick(Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive);
+
+    /**
+     * @brief addPattern This method adds the pattern into automaton. The automaton should be built again after this method.
+     * @param pattern This is substring for search. The empty pattern is found in any text (same as QString::contains).
+     * @param id This is id of pattern that returned by the search methods.
+     */
+    void addPattern(const QString& pattern, int id);
+
+    /**
+     * @brief build This method compiles all added patterns.
+     */
+    void build();
+
+    /**
+     * @brief matches This method returns ids of all patterns that found in the text.
+     * @param text This is text for search.
+     * @return sorted list of unique ids.
+     */
+    QVector<int> matches(const QString& text) const;
+
+    /**
+     * @brief firstMatch This method returns the lowest id of the patterns that found in the text.
+     * @param text This is text for search.
+     * @return id of pattern or -1 if no one pattern is found.
+     */
+    int firstMatch(const QString& text) const;
+
+    bool isEmpty() const;
+    void clear();
+
+private:
+    struct Node {
+        QHash<ushort, int> next;
+        int fail = 0;
+        QVector<int> output;
+    };
+
+    ushort fold(QChar symbol) const;
+    int step(int state, ushort symbol) const;
+
+    template<typename Callback>
+    void search(const QString& text, Callback callback) const;
+
+    Qt::CaseSensitivity _caseSensitivity;
+    QVector<Node> _nodes;
+    QVector<int> _emptyPatterns;
+    bool _builded = false;
+};
+
+#endif // AHOCORASICK_H
@@ -17,6 +17,7 @@
 #include "pathutils.h"
 #include "pluginsparser.h"
 #include "quasarapp.h"
+#include "zipwriter.h"
 
 #include <cassert>
 
@@ -534,6 +535,20 @@ bool ConfigParser::initPackages() {
 
     _config.setDefaultPackage(defaultPackage);
 
+    if (QuasarAppUtils::Params::isEndable("splitDebug")) {
+        _config.debugPackage = PathUtils::fullStripPath(QuasarAppUtils::Params::getStrArg("splitDebug"));
+        if (_config.debugPackage.isEmpty()) {
+            _config.debugPackage = defaultPackage + "Debug";
+        }
+
+        if (!_config.packages().contains(_config.debugPackage)) {
+            _config.packagesEdit().insert(_config.debugPackage, DistroModule{_config.debugPackage});
+        }
+
+        QuasarAppUtils::Params::log("The debug information will be saved into the " + _config.debugPackage + " package",
+                                    QuasarAppUtils::Info);
+    }
+
     return true;
 }
 
@@ -636,6 +651,49 @@ bool ConfigParser::parseDeployMode() {
         }
     }
 
+    _config.jobs = 0;
+
+    if (QuasarAppUtils::Params::isEndable("jobs")) {
+        bool ok;
+        _config.jobs = QuasarAppUtils::Params::getArg("jobs").toInt(&ok);
+        if (!ok || _config.jobs < 1) {
+            _config.jobs = 0;
+            QuasarAppUtils::Params::log("jobs is invalid! use count of cpu cores",
+                                        QuasarAppUtils::Warning);
+        }
+    }
+
+    _config.ioJobs = 0;
+
+    if (QuasarAppUtils::Params::isEndable("ioJobs")) {
+        bool ok;
+        _config.ioJobs = QuasarAppUtils::Params::getArg("ioJobs").toInt(&ok);
+        if (!ok || _config.ioJobs < 1) {
+            _config.ioJobs = 0;
+            QuasarAppUtils::Params::log("ioJobs is invalid! use count of cpu cores",
+                                        QuasarAppUtils::Warning);
+        }
+    }
+
+    _config.zipLevel = ZipWriter::DefaultLevel;
+
+    if (QuasarAppUtils::Params::isEndable("zipLevel")) {
+        bool ok;
+        _config.zipLevel = QuasarAppUtils::Params::getArg("zipLevel").toInt(&ok);
+        if (!ok || _config.zipLevel < 0 || _config.zipLevel > 9) {
+            _config.zipLevel = ZipWriter::DefaultLevel;
+            QuasarAppUtils::Params::log("zipLevel is invalid! use default value 6",
+                                        QuasarAppUtils::Warning);
+        }
+    }
+
+    CopyBackend::Backend copyMode;
+    if (!CopyBackend::fromString(QuasarAppUtils::Params::getStrArg("copyMode"), copyMode)) {
+        CopyBackend::fromString("auto", copyMode);
+        QuasarAppUtils::Params::log("copyMode is invalid! use auto mode",
+                                    QuasarAppUtils::Warning);
+    }
+    _fileManager->copyBackend().setFirstBackend(copyMode);
 
     if (!initRunScripts()) {
         return false;
@@ -885,12 +943,10 @@ void ConfigParser::initIgnoreList()
 
     if (!QuasarAppUtils::Params::isEndable("deploySystem-with-libc")) {
 
-        envUnix.addEnv(Envirement::recursiveInvairement("/lib", 3));
-        envUnix.addEnv(Envirement::recursiveInvairement("/usr/lib", 3));
+        envUnix.addEnv(getSystemLibDirs(false));
 
         if (DeployCore::isSnap()) {
-            envUnix.addEnv(Envirement::recursiveInvairement(DeployCore::transportPathToSnapRoot("/lib"), 3));
-            envUnix.addEnv(Envirement::recursiveInvairement(DeployCore::transportPathToSnapRoot("/usr/lib"), 3));
+            envUnix.addEnv(getSystemLibDirs(true));
         }
 
         ruleUnix.prority = SystemLib;
@@ -1323,6 +1379,58 @@ bool ConfigParser::initPlugins() {
     return true;
 }
 
+const LdCache &ConfigParser::ldCache(bool snapRoot) {
+    const QString path = (snapRoot)? DeployCore::transportPathToSnapRoot(LdCache::defaultLocation()):
+                                     LdCache::defaultLocation();
+
+    auto it = _ldCaches.find(path);
+    if (it == _ldCaches.end()) {
+        it = _ldCaches.insert(path, {});
+        it->load(path);
+    }
+
+    return it.value();
+}
+
+QStringList ConfigParser::getSystemLibDirs(bool snapRoot) {
+    auto transport = [snapRoot](const QString& path) {
+        return (snapRoot)? DeployCore::transportPathToSnapRoot(path): path;
+    };
+
+    const LdCache &cache = ldCache(snapRoot);
+    if (!cache.isLoaded()) {
+        return Envirement::recursiveInvairement(transport("/lib"), 5) +
+                Envirement::recursiveInvairement(transport("/usr/lib"), 5);
+    }
+
+    QStringList result = {transport("/lib"), transport("/usr/lib")};
+    const QStringList cachedDirs = cache.dirs();
+    QStringList dirs = cachedDirs;
+
+    for (const auto& dir: cachedDirs) {
+        // the /lib directory is link to the /usr/lib on the systems with merged /usr.
+        dirs.push_back((dir.startsWith("/usr/"))? dir.mid(4): "/usr" + dir);
+    }
+
+    for (const auto& dir: qAsConst(dirs)) {
+        QDir libDir(transport(dir));
+        if (!libDir.exists()) {
+            continue;
+        }
+
+        result.push_back(libDir.absolutePath());
+
+        // the subdirectories contains the plugins of the system libraries (for example gconv).
+        const auto subDirs = libDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const auto& subDir: subDirs) {
+            result.push_back(subDir.absoluteFilePath());
+        }
+    }
+
+    result.removeDuplicates();
+    return result;
+}
+
 QString ConfigParser::findWindowsPath(const QString& path) const {
     auto list = path.split(';');
     QString win_magic = "windows";
@@ -1381,6 +1489,9 @@ void ConfigParser::initEnvirement() {
     dirs.append(getDirsRecursive(DeployCore::transportPathToSnapRoot("/lib"), 5));
     dirs.append(getDirsRecursive(DeployCore::transportPathToSnapRoot("/usr/lib"), 5));
 
+    // the libraries from other directories of the dynamic linker are found by the cache.
+    _config.ldCache = ldCache(true);
+
 #else
     auto winPath = findWindowsPath(path);
     dirs.append(getDirsRecursive(winPath + "/System32", 2));
@@ -11,6 +11,7 @@
 #include "distrostruct.h"
 #include "envirement.h"
 #include "ignorerule.h"
+#include "ldcache.h"
 #include "targetdata.h"
 #include "targetinfo.h"
 
@@ -48,6 +49,11 @@ private:
 
     QHash<QString, QString> _Targetpackages;
 
+    /**
+     * @brief _ldCaches This is loaded caches of the dynamic linker (key - path to the cache file).
+     */
+    QHash<QString, LdCache> _ldCaches;
+
     bool createFromDeploy(const QString& file) const;
     bool loadFromFile(const QString& file);
     bool initDistroStruct();
@@ -108,6 +114,21 @@ private:
     QJsonValue writeKeyArray(int separatorLvl, const QString &parameter, const QString &confFileDir) const;
     QString findWindowsPath(const QString &path) const;
 
+    /**
+     * @brief getSystemLibDirs This method returns the directories of the system libraries.
+     *  The directories are read from the ld.so.cache file, the recursive walk of the /lib and the /usr/lib directories is used only when the cache is not available.
+     * @param snapRoot Set this option to true for read the libraries of the host system from the snap.
+     * @return list of directories.
+     */
+    QStringList getSystemLibDirs(bool snapRoot);
+
+    /**
+     * @brief ldCache This method returns the cache of the dynamic linker. The cache file is read only once.
+     * @param snapRoot Set this option to true for read the cache of the host system from the snap.
+     * @return the cache of the dynamic linker. If the cache is not exists then returns not loaded cache.
+     */
+    const LdCache& ldCache(bool snapRoot);
+
     QList<iDistribution *> getDistribution();
 
     QtMajorVersion isNeededQt() const;
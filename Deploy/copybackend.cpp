@@ -0,0 +1,383 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "copybackend.h"
+#include "parallel.h"
+
+#include <QFile>
+#include <QStringList>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+#endif
+
+namespace {
+
+#ifdef Q_OS_LINUX
+
+// max size of the one call of the sendfile and copy_file_range (same as the kernel limit).
+const qint64 MaxChunk = 0x7ffff000;
+
+enum class Status {
+    Done,
+    NotSupported,
+    Failed
+};
+
+// errors that mean the method can not be used for this pair of the files, but another method can be.
+bool isNotSupported(int error) {
+    switch (error) {
+    case ENOSYS:
+    case EOPNOTSUPP:
+#if ENOTSUP != EOPNOTSUPP
+    case ENOTSUP:
+#endif
+    case EXDEV:
+    case EINVAL:
+    case ENOTTY:
+    case EPERM:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Status reflink(int src, int dst, qint64) {
+    if (ioctl(dst, FICLONE, src) == 0) {
+        return Status::Done;
+    }
+
+    return isNotSupported(errno)? Status::NotSupported: Status::Failed;
+}
+
+Status copyFileRange(int src, int dst, qint64 size) {
+#ifdef SYS_copy_file_range
+    qint64 copied = 0;
+    while (copied < size) {
+        auto result = syscall(SYS_copy_file_range, src, nullptr, dst, nullptr,
+                              static_cast<size_t>(qMin(size - copied, MaxChunk)), 0u);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return isNotSupported(errno)? Status::NotSupported: Status::Failed;
+        }
+
+        if (result == 0) {
+            // some file systems (procfs, sysfs) returns zero instead of error.
+            return (copied)? Status::Failed : Status::NotSupported;
+        }
+
+        copied += result;
+    }
+
+    return Status::Done;
+#else
+    Q_UNUSED(src)
+    Q_UNUSED(dst)
+    Q_UNUSED(size)
+    errno = ENOSYS;
+    return Status::NotSupported;
+#endif
+}
+
+Status sendFile(int src, int dst, qint64 size) {
+    qint64 copied = 0;
+    while (copied < size) {
+        auto result = sendfile(dst, src, nullptr, static_cast<size_t>(qMin(size - copied, MaxChunk)));
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return isNotSupported(errno)? Status::NotSupported: Status::Failed;
+        }
+
+        if (result == 0) {
+            return (copied)? Status::Failed : Status::NotSupported;
+        }
+
+        copied += result;
+    }
+
+    return Status::Done;
+}
+
+#endif
+
+}
+
+CopyBackend::CopyBackend() {
+#ifdef Q_OS_LINUX
+    _firstBackend = Reflink;
+#else
+    _firstBackend = QtCopy;
+#endif
+}
+
+bool CopyBackend::fromString(const QString &mode, Backend &result) {
+    if (mode.isEmpty() || mode.compare("auto", Qt::CaseInsensitive) == 0) {
+        result = CopyBackend().firstBackend();
+        return true;
+    }
+
+    for (int i = 0; i < BackendsCount; ++i) {
+        if (mode.compare(name(static_cast<Backend>(i)), Qt::CaseInsensitive) == 0) {
+            result = static_cast<Backend>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+QString CopyBackend::name(Backend backend) {
+    switch (backend) {
+    case Reflink: return "reflink";
+    case CopyFileRange: return "range";
+    case SendFile: return "sendfile";
+    case QtCopy: return "qt";
+    case Uring: return "uring";
+    default: return "";
+    }
+}
+
+void CopyBackend::setFirstBackend(Backend backend) {
+#ifdef Q_OS_LINUX
+    _firstBackend = backend;
+#else
+    Q_UNUSED(backend)
+#endif
+}
+
+CopyBackend::Backend CopyBackend::firstBackend() const {
+    return static_cast<Backend>(_firstBackend.loadAcquire());
+}
+
+bool CopyBackend::copy(const QString &from, const QString &to, QString *error) {
+    Backend used = QtCopy;
+    switch (kernelCopy(from, to, used, error)) {
+    case Done:
+        return true;
+    case Failed:
+        return false;
+    case NotSupported:
+        break;
+    }
+
+    QFile source(from);
+    qint64 size = source.size();
+    if (!source.copy(to)) {
+        if (error) {
+            *error = source.errorString();
+        }
+        return false;
+    }
+
+    account(QtCopy, size);
+    return true;
+}
+
+bool CopyBackend::isBatchEnabled() const {
+    return firstBackend() == Uring && UringCopier::isSupported();
+}
+
+void CopyBackend::copy(QVector<UringCopier::Task> &tasks) {
+    if (isBatchEnabled()) {
+        UringCopier copier;
+        copier.copy(tasks);
+    }
+
+    QVector<int> notHandled;
+    for (int i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].status == UringCopier::Done) {
+            account(Uring, tasks[i].size);
+        } else if (tasks[i].status == UringCopier::NotHandled) {
+            notHandled.push_back(i);
+        }
+    }
+
+    // the files skipped by the io_uring (big files, special files or not supported kernel) are copied on the io workers.
+    UringCopier::Task *data = tasks.data();
+    Parallel::forEach(notHandled.size(), [this, data, &notHandled](int index) {
+        auto &task = data[notHandled[index]];
+        task.status = copy(task.from, task.to, &task.error)? UringCopier::Done: UringCopier::Failed;
+    }, Parallel::ioJobs());
+}
+
+CopyBackend::Result CopyBackend::kernelCopy(const QString &from, const QString &to,
+                                            Backend &used, QString *error) {
+#ifdef Q_OS_LINUX
+    int first = _firstBackend.loadAcquire();
+    if (first == QtCopy) {
+        return NotSupported;
+    }
+
+    if (first == Uring) {
+        first = Reflink;
+    }
+
+    int src = ::open(QFile::encodeName(from).constData(), O_RDONLY | O_CLOEXEC);
+    if (src < 0) {
+        return NotSupported;
+    }
+
+    struct stat info;
+    if (fstat(src, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(src);
+        return NotSupported;
+    }
+
+    const QByteArray target = QFile::encodeName(to);
+    int dst = ::open(target.constData(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (dst < 0) {
+        ::close(src);
+        if (errno == EEXIST) {
+            if (error) {
+                *error = "Destination file exists";
+            }
+            return Failed;
+        }
+
+        return NotSupported;
+    }
+
+    Status (*methods[])(int, int, qint64) = {reflink, copyFileRange, sendFile};
+
+    Status status = Status::NotSupported;
+    int lastError = 0;
+    for (int backend = first; backend < QtCopy; ++backend) {
+        if (_disabled.loadAcquire() & (1 << backend)) {
+            continue;
+        }
+
+        const quint64 device = static_cast<quint64>(info.st_dev);
+        if (backend == Reflink && !isReflinkSupported(device)) {
+            continue;
+        }
+
+        status = methods[backend](src, dst, info.st_size);
+        if (status != Status::NotSupported) {
+            used = static_cast<Backend>(backend);
+            lastError = errno;
+            break;
+        }
+
+        if (errno == ENOSYS) {
+            // the kernel does not support this call, so do not try it again.
+            _disabled.fetchAndOrOrdered(1 << backend);
+        } else if (backend == Reflink && (errno == EOPNOTSUPP || errno == ENOTSUP || errno == EXDEV)) {
+            // the file system of the target (or the pair of the file systems) does not support the reflink.
+            disableReflink(device);
+        }
+
+        // the method can be failed after writing of the part of data, so start from scratch.
+        if (ftruncate(dst, 0) != 0 || lseek(src, 0, SEEK_SET) != 0 || lseek(dst, 0, SEEK_SET) != 0) {
+            status = Status::Failed;
+            lastError = errno;
+            break;
+        }
+    }
+
+    if (status == Status::Done && fchmod(dst, info.st_mode & 07777) != 0) {
+        status = Status::Failed;
+        lastError = errno;
+    }
+
+    if (::close(dst) != 0 && status == Status::Done) {
+        status = Status::Failed;
+        lastError = errno;
+    }
+    ::close(src);
+
+    switch (status) {
+    case Status::Done:
+        account(used, info.st_size);
+        return Done;
+    case Status::Failed:
+        if (error) {
+            *error = QString::fromLocal8Bit(strerror(lastError));
+        }
+        ::unlink(target.constData());
+        return Failed;
+    case Status::NotSupported:
+        break;
+    }
+
+    ::unlink(target.constData());
+    return NotSupported;
+#else
+    Q_UNUSED(from)
+    Q_UNUSED(to)
+    Q_UNUSED(used)
+    Q_UNUSED(error)
+    return NotSupported;
+#endif
+}
+
+bool CopyBackend::isReflinkSupported(quint64 device) const {
+    QReadLocker locker(&_noReflinkLock);
+    return !_noReflinkDevices.contains(device);
+}
+
+void CopyBackend::disableReflink(quint64 device) {
+    QWriteLocker locker(&_noReflinkLock);
+    _noReflinkDevices.insert(device);
+}
+
+void CopyBackend::account(Backend backend, qint64 size) {
+    _bytes[backend].fetchAndAddRelaxed(size);
+    _files[backend].fetchAndAddRelaxed(1);
+}
+
+qint64 CopyBackend::bytes(Backend backend) const {
+    return _bytes[backend].loadAcquire();
+}
+
+int CopyBackend::files(Backend backend) const {
+    return _files[backend].loadAcquire();
+}
+
+QString CopyBackend::report() const {
+    QStringList result;
+    for (int i = 0; i < BackendsCount; ++i) {
+        auto backend = static_cast<Backend>(i);
+        if (!files(backend)) {
+            continue;
+        }
+
+        result.push_back(QString("%0: %1 files (%2 bytes)").
+                         arg(name(backend)).
+                         arg(files(backend)).
+                         arg(bytes(backend)));
+    }
+
+    if (result.isEmpty()) {
+        return "No files copied";
+    }
+
+    return "Copied files: " + result.join(", ");
+}
+
+void CopyBackend::resetStatistic() {
+    for (int i = 0; i < BackendsCount; ++i) {
+        _bytes[i] = 0;
+        _files[i] = 0;
+    }
+}
@@ -0,0 +1,127 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef COPYBACKEND_H
+#define COPYBACKEND_H
+
+#include "deploy_global.h"
+#include "uringcopier.h"
+
+#include <QAtomicInteger>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QString>
+
+/**
+ * @brief The CopyBackend class copies the files with the fastest method that supported by the file system.
+ * The methods are tried in next order: FICLONE reflink, copy_file_range, sendfile and QFile::copy.
+ * The kernel methods are available only on linux, on other platforms files are copied with the QFile::copy.
+ * If the reflink is not supported for the device of the source file (EOPNOTSUPP or EXDEV) then it is not tried again for this device.
+ * The batches of the small files can be copied with io_uring (see the UringCopier class), this method is enabled by the Uring backend.
+ * This class is thread-safe.
+ */
+class DEPLOYSHARED_EXPORT CopyBackend
+{
+public:
+    enum Backend: int {
+        Reflink,
+        CopyFileRange,
+        SendFile,
+        QtCopy,
+        /// io_uring for the batches of the small files, single files are copied starting from the Reflink method.
+        Uring,
+        BackendsCount
+    };
+
+    CopyBackend();
+    CopyBackend(const CopyBackend&) = delete;
+    CopyBackend& operator=(const CopyBackend&) = delete;
+
+    /**
+     * @brief fromString This method converts value of the copyMode option to first backend.
+     * @param mode This is value of option (auto, reflink, range, sendfile, qt, uring).
+     * @param result This is result backend.
+     * @return true if the mode is valid.
+     */
+    static bool fromString(const QString& mode, Backend& result);
+
+    /**
+     * @brief name This method returns name of backend used in the copyMode option.
+     * @param backend This is backend.
+     * @return name of the backend.
+     */
+    static QString name(Backend backend);
+
+    /**
+     * @brief setFirstBackend This method sets backend that will be tried first. All next backends are used as fallback.
+     * @param backend This is first backend.
+     */
+    void setFirstBackend(Backend backend);
+    Backend firstBackend() const;
+
+    /**
+     * @brief copy This method copies the file with the permissions. The target file must not exist (same as QFile::copy).
+     * @param from This is path to source file.
+     * @param to This is path to target file.
+     * @param error This is description of the error if copy is failed.
+     * @return true if file copied.
+     */
+    bool copy(const QString& from, const QString& to, QString* error = nullptr);
+
+    /**
+     * @brief isBatchEnabled This method returns true if the batches of files should be copied with the copy(tasks) method.
+     * @return true if the Uring backend is selected and supported by the kernel.
+     */
+    bool isBatchEnabled() const;
+
+    /**
+     * @brief copy This method copies the batch of files with io_uring. Files that not copied by io_uring are copied with the copy(from, to) method.
+     * @param tasks This is list of files. The status of the every task will be updated (Done or Failed).
+     */
+    void copy(QVector<UringCopier::Task>& tasks);
+
+    /**
+     * @brief bytes This method returns count of bytes copied by the backend.
+     */
+    qint64 bytes(Backend backend) const;
+
+    /**
+     * @brief files This method returns count of files copied by the backend.
+     */
+    int files(Backend backend) const;
+
+    /**
+     * @brief report This method returns statistic of the copied data for the log.
+     */
+    QString report() const;
+
+    void resetStatistic();
+
+private:
+    enum Result {
+        Done,
+        NotSupported,
+        Failed
+    };
+
+    Result kernelCopy(const QString& from, const QString& to, Backend& used, QString* error);
+    void account(Backend backend, qint64 size);
+
+    bool isReflinkSupported(quint64 device) const;
+    void disableReflink(quint64 device);
+
+    QAtomicInt _firstBackend;
+    QAtomicInt _disabled;
+
+    /// devices of the source files that can not be cloned into the targets.
+    QSet<quint64> _noReflinkDevices;
+    mutable QReadWriteLock _noReflinkLock;
+    QAtomicInteger<qint64> _bytes[BackendsCount];
+    QAtomicInt _files[BackendsCount];
+};
+
+#endif // COPYBACKEND_H
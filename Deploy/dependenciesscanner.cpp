@@ -12,14 +12,21 @@
 #include <QList>
 #include <QDir>
 #include <QDebug>
+#include "parallel.h"
 #include "pathutils.h"
 
+#include <algorithm>
+#include <vector>
+
 DependenciesScanner::DependenciesScanner() {
 
 }
 
 void DependenciesScanner::clearScaned() {
-    _scanedLibs.clear();
+    _graph.clear();
+
+    QWriteLocker locker(&_parsedLibsLock);
+    _parsedLibs.clear();
 }
 
 PrivateScaner DependenciesScanner::getScaner(const QString &lib) const {
@@ -38,61 +45,164 @@ PrivateScaner DependenciesScanner::getScaner(const QString &lib) const {
     return PrivateScaner::UNKNOWN;
 }
 
-QMultiMap<LibPriority, LibInfo> DependenciesScanner::getLibsFromEnvirement(
-        const QString &libName) const {
+QString DependenciesScanner::EnvLib::fullPath() const {
+    return dir + "/" + name;
+}
 
-    auto values = _EnvLibs.values(libName.toUpper());
-    QMultiMap<LibPriority, LibInfo> res;
+QVector<DependenciesScanner::EnvLib> DependenciesScanner::getCachedLib(
+        const QString &libName, Platform platform) const {
 
-    for (const auto & lib : values) {
-        LibInfo info;
+    if (!(platform & Platform::Unix)) {
+        return {};
+    }
 
-        if (_scanedLibs.contains(lib)) {
-            info = _scanedLibs.value(lib);
+    const QString path = DeployCore::_config->ldCache.find(libName, platform);
+    if (path.isEmpty()) {
+        return {};
+    }
 
-            if ((info.priority >= SystemLib) && !QuasarAppUtils::Params::isEndable("deploySystem")) {
-                continue;
-            }
+    QFileInfo info(DeployCore::transportPathToSnapRoot(path));
+    if (!info.isFile()) {
+        return {};
+    }
 
-        } else {
+    EnvLib lib;
+    lib.dir = info.absolutePath();
+    lib.name = info.fileName();
+    lib.platform = platform;
+    lib.priority = _priorities.priority(info.absoluteFilePath());
 
-            auto priority = (DeployCore::getLibPriority(lib));
+    return {lib};
+}
 
-            if ((priority >= SystemLib) && !QuasarAppUtils::Params::isEndable("deploySystem")) {
-                continue;
-            }
+QVector<DependenciesScanner::EnvLib> DependenciesScanner::getEnvCandidates(
+        const QString &libName, Platform platform) const {
 
-            info.setPriority(priority);
+    QVector<EnvLib> res;
 
-            if (!fillLibInfo(info, lib)) {
-                QuasarAppUtils::Params::log(
-                            "error extract lib info from " + lib + "(" + libName + ")",
-                            QuasarAppUtils::VerboseLvl::Warning);
-                continue;
-            }
+    QVector<EnvLib> libs = _EnvLibs.value(libName.toUpper());
+    if (libs.isEmpty()) {
+        libs = getCachedLib(libName, platform);
+    }
+
+    bool deploySystem = QuasarAppUtils::Params::isEndable("deploySystem");
+
+    for (const auto & lib : qAsConst(libs)) {
+        if (lib.platform != platform) {
+            continue;
         }
 
-        if (!DeployCore::_config->ignoreList.isIgnore(info)) {
-            res.insert(info.getPriority(), info);
+        if ((lib.priority >= SystemLib) && !deploySystem) {
+            continue;
+        }
+
+        LibInfo info;
+        info.setName(lib.name);
+        info.setPath(lib.dir);
+        info.setPlatform(lib.platform);
+        info.setPriority(lib.priority);
+
+        if (DeployCore::_config->ignoreList.isIgnore(info)) {
+            continue;
         }
 
+        res.push_back(lib);
     }
 
+    std::stable_sort(res.begin(), res.end(), [](const EnvLib& left, const EnvLib& right) {
+        return left.priority < right.priority;
+    });
+
     return res;
 }
 
+bool DependenciesScanner::getLibFromEnvirement(const QString &libName,
+                                               Platform platform,
+                                               LibInfo &info) const {
+
+    const auto candidates = getEnvCandidates(libName, platform);
+
+    for (const auto & lib : candidates) {
+        const QString path = lib.fullPath();
+
+        auto id = _graph.find(path);
+        if (id != LibGraph::InvalidNode) {
+            info = _graph.node(id);
+            return true;
+        }
+
+        if (!parseLib(path, info) || info.getPlatform() != platform) {
+            QuasarAppUtils::Params::log(
+                        "error extract lib info from " + path + "(" + libName + ")",
+                        QuasarAppUtils::VerboseLvl::Warning);
+            continue;
+        }
+
+        info.setPriority(lib.priority);
+        return true;
+    }
+
+    return false;
+}
+
+Platform DependenciesScanner::getPlatform(const QString &file) const {
+    switch (getScaner(file)) {
+    case PrivateScaner::PE:
+        return _peScaner.getPlatform(file);
+    case PrivateScaner::ELF:
+        return _elfScaner.getPlatform(file);
+    default:
+        return UnknownPlatform;
+    }
+}
+
 bool DependenciesScanner::fillLibInfo(LibInfo &info, const QString &file) const {
 
     info.clear();
     auto scaner = getScaner(file);
 
+    bool useCache = !QuasarAppUtils::Params::isEndable("noScanCache");
+
+    // The qtPath is not parsed when the noCheckRPATH option is enabled, so the records can not be shared with other runs.
+    bool checkRPATH = !QuasarAppUtils::Params::isEndable("noCheckRPATH");
+
     switch (scaner) {
     case PrivateScaner::PE: {
-        return _peScaner.getLibInfo(file, info);
+        if (useCache && _cache.find(file, info)) {
+            _peScaner.addWinAPIDependencies(info);
+            return true;
+        }
+
+        if (!_peScaner.getLibInfo(file, info)) {
+            return false;
+        }
+
+        if (useCache) {
+            _cache.insert(file, info);
+        }
+
+        _peScaner.addWinAPIDependencies(info);
+        return true;
     }
 
     case PrivateScaner::ELF: {
-        return _elfScaner.getLibInfo(file, info);
+        if (useCache && _cache.find(file, info)) {
+            if (!checkRPATH) {
+                info.setQtPath("");
+            }
+
+            return true;
+        }
+
+        if (!_elfScaner.getLibInfo(file, info)) {
+            return false;
+        }
+
+        if (useCache && checkRPATH) {
+            _cache.insert(file, info);
+        }
+
+        return true;
     }
 
     default:
@@ -100,73 +210,73 @@ bool DependenciesScanner::fillLibInfo(LibInfo &info, const QString &file) const
     }
 }
 
-void DependenciesScanner::recursiveDep(LibInfo &lib, QSet<LibInfo> &res, QSet<QString>& libStack) {
-    QuasarAppUtils::Params::log("get recursive dependencies of " + lib.fullPath(),
-                                       QuasarAppUtils::Debug);
-
-    if (_scanedLibs.contains(lib.fullPath())) {
-        auto scanedLib = _scanedLibs.value(lib.fullPath());
-
-        if (!scanedLib.isValid()) {
-            QuasarAppUtils::Params::log( "no valid lib in scaned libs list!",
-                                               QuasarAppUtils::Error);
-            return;
+bool DependenciesScanner::parseLib(const QString &file, LibInfo &info) const {
+    {
+        QReadLocker locker(&_parsedLibsLock);
+        auto it = _parsedLibs.constFind(file);
+        if (it != _parsedLibs.constEnd()) {
+            info = it.value();
+            return info.getPlatform() != UnknownPlatform;
         }
-
-        res.unite(scanedLib.allDep);
-
-        return;
     }
 
-    if (libStack.contains(lib.fullPath())) {
-        QuasarAppUtils::Params::log("A recursive dependency was found in library " + lib.fullPath(),
-                                           QuasarAppUtils::Warning);
-        return;
+    LibInfo parsed;
+    if (!fillLibInfo(parsed, file)) {
+        parsed.clear();
     }
 
-    libStack.insert(lib.fullPath());
+    QWriteLocker locker(&_parsedLibsLock);
+    _parsedLibs.insert(file, parsed);
+    info = parsed;
+
+    return info.getPlatform() != UnknownPlatform;
+}
 
-    for (auto i : lib.dependncies) {
+void DependenciesScanner::resolve(LibGraph::NodeId root) {
+    QVector<LibGraph::NodeId> stack = {root};
 
-        auto libs = getLibsFromEnvirement(i);
+    while (stack.size()) {
+        auto id = stack.takeLast();
 
-        if (!libs.size()) {
-            QuasarAppUtils::Params::log("lib for dependese " + i + " not findet!!",
-                                               QuasarAppUtils::Warning);
+        if (_graph.isResolved(id)) {
             continue;
         }
 
-        auto dep = libs.begin();
+        // copy of node because the insert method invalidates references.
+        const LibInfo lib = _graph.node(id);
 
-        while (dep != libs.end() &&
-               dep.value().platform != lib.platform) dep++;
+        QuasarAppUtils::Params::log("get recursive dependencies of " + lib.fullPath(),
+                                    QuasarAppUtils::Debug);
 
-        if (dep != libs.end() && !res.contains(*dep)) {
-            res.insert(*dep);
+        QVector<LibGraph::NodeId> edges;
+        QVector<LibGraph::NodeId> shallowEdges;
 
-            LibInfo scanedLib = _scanedLibs.value(dep->fullPath());
+        for (const auto &i : lib.getDependncies()) {
 
-            if (!scanedLib.isValid()) {
-                QSet<LibInfo> listDep =  {};
-
-                if (!lib.name.compare(dep.value().name, ONLY_WIN_CASE_INSENSIATIVE))
-                    continue;
+            LibInfo dep;
+            if (!getLibFromEnvirement(i, lib.getPlatform(), dep)) {
+                QuasarAppUtils::Params::log("lib for dependese " + i + " not findet!!",
+                                            QuasarAppUtils::Warning);
+                continue;
+            }
 
-                recursiveDep(*dep, listDep, libStack);
+            auto depId = _graph.insert(dep);
 
-                dep->allDep = listDep;
-                lib.setWinApi(lib.getWinApi() | dep->getWinApi());
-                _scanedLibs.insert(dep->fullPath(), *dep);
+            // the library with same name (for example the wrapper of the system library) is deployed,
+            // but the dependencies of it are not included into the dependencies of this library.
+            auto &list = (lib.getName().compare(dep.getName(), ONLY_WIN_CASE_INSENSIATIVE))? edges: shallowEdges;
+            if (!list.contains(depId)) {
+                list.push_back(depId);
+            }
 
-                res.unite(listDep);
-            } else {
-                lib.setWinApi(lib.getWinApi() | scanedLib.getWinApi());
-                res.unite(scanedLib.allDep);
+            // all nodes are resolved, so the closures of the nodes do not depend on order of the scanned targets.
+            if (!_graph.isResolved(depId)) {
+                stack.push_back(depId);
             }
         }
-    }
 
-    libStack.remove(lib.fullPath());
+        _graph.setEdges(id, edges, shallowEdges);
+    }
 }
 
 void DependenciesScanner::addToWinAPI(const QString &lib, QHash<WinAPI, QSet<QString>>& res) {
@@ -192,41 +302,146 @@ void DependenciesScanner::setEnvironment(const QStringList &env) {
     winAPI[WinAPI::Crt] += "UCRTBASE.DLL";
 #endif
 
-    for (auto i : env) {
+    _priorities.compile(DeployCore::_config);
+
+    QVector<EnvLib> libs;
+
+    for (const auto &i : env) {
 
         dir.setPath(i);
         if (!dir.exists()) {
             continue;
         }
 
-        auto list = dir.entryInfoList(QStringList() << "*.dll" << "*.DLL"
-                                      << "*.SO*" << "*.so*",
-                                      QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden);
+        const QString path = dir.absolutePath();
+        const auto list = dir.entryList(QStringList() << "*.dll" << "*.DLL"
+                                        << "*.SO*" << "*.so*",
+                                        QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden);
 
-        for (auto i : list) {
-            addToWinAPI(i.fileName().toUpper(), winAPI);
-            _EnvLibs.insert(i.fileName().toUpper(), i.absoluteFilePath());
+        for (const auto &name : list) {
+            EnvLib lib;
+            lib.dir = path;
+            lib.name = name;
+            libs.push_back(lib);
         }
-
     }
 
+    // read only headers of the files, the full parsing will be run for the required candidates only.
+    Parallel::forEach(libs.size(), [this, &libs](int index) {
+        auto &lib = libs[index];
+        const QString fullPath = lib.fullPath();
+
+        lib.platform = getPlatform(fullPath);
+        if (lib.platform != UnknownPlatform) {
+            lib.priority = _priorities.priority(fullPath);
+        }
+    });
+
+    for (const auto &lib : qAsConst(libs)) {
+        if (lib.platform == UnknownPlatform) {
+            continue;
+        }
+
+        const QString key = lib.name.toUpper();
+        addToWinAPI(key, winAPI);
+        _EnvLibs[key].push_back(lib);
+    }
 
     _peScaner.setWinAPI(winAPI);
 }
 
-QSet<LibInfo> DependenciesScanner::scan(const QString &path) {
-    QSet<LibInfo> result;
-
+LibGraphView DependenciesScanner::scan(const QString &path) {
     LibInfo info;
 
-    if (!fillLibInfo(info, path)) {
-        return result;
+    if (!parseLib(path, info)) {
+        return {};
     }
 
-    QSet<QString> stack;
-    recursiveDep(info, result, stack);
+    auto root = _graph.find(info.fullPath());
+    if (root == LibGraph::InvalidNode) {
+        info.setPriority(_priorities.priority(info.fullPath()));
+        root = _graph.insert(info);
+    }
+
+    resolve(root);
+
+    return LibGraphView(&_graph, _graph.closure(root));
+}
 
-    return result;
+void DependenciesScanner::preScan(const QStringList &files) {
+    QSet<QString> queued;
+    QStringList wave;
+
+    for (const auto &file : files) {
+        if (!queued.contains(file)) {
+            queued.insert(file);
+            wave.push_back(file);
+        }
+    }
+
+    // The first wave contains the input files, all next waves contains the found dependencies.
+    while (wave.size()) {
+        const QStringList &current = wave;
+        std::vector<QStringList> dependencies(static_cast<size_t>(current.size()));
+
+        Parallel::forEach(current.size(), [&](int index) {
+            const QString &file = current.at(index);
+
+            LibInfo info;
+            if (!parseLib(file, info)) {
+                return;
+            }
+
+            auto &result = dependencies[static_cast<size_t>(index)];
+            for (const auto &dep : info.getDependncies()) {
+                const auto candidates = getEnvCandidates(dep, info.getPlatform());
+                for (const auto &lib : candidates) {
+                    result += lib.fullPath();
+                }
+            }
+        });
+
+        QStringList next;
+        for (const auto &list : dependencies) {
+            for (const auto &lib : list) {
+                if (!queued.contains(lib)) {
+                    queued.insert(lib);
+                    next.push_back(lib);
+                }
+            }
+        }
+
+        wave = next;
+    }
+}
+
+void DependenciesScanner::initCache() {
+    if (QuasarAppUtils::Params::isEndable("clearScanCache")) {
+        if (!_cache.purge()) {
+            QuasarAppUtils::Params::log("Failed to remove the cache of libraries " + _cache.location(),
+                                        QuasarAppUtils::Warning);
+        }
+    }
+
+    if (QuasarAppUtils::Params::isEndable("noScanCache")) {
+        return;
+    }
+
+    if (_cache.load()) {
+        QuasarAppUtils::Params::log(QString("Loaded %0 records from the cache of libraries").arg(_cache.size()),
+                                    QuasarAppUtils::Debug);
+    }
+}
+
+void DependenciesScanner::saveCache() {
+    if (QuasarAppUtils::Params::isEndable("noScanCache")) {
+        return;
+    }
+
+    if (!_cache.save()) {
+        QuasarAppUtils::Params::log("Failed to save the cache of libraries " + _cache.location(),
+                                    QuasarAppUtils::Warning);
+    }
 }
 
 DependenciesScanner::~DependenciesScanner() {
@@ -9,12 +9,16 @@
 #define WINDEPENDENCIESSCANNER_H
 
 #include <QMultiMap>
+#include <QReadWriteLock>
 #include <QStringList>
 #include "deploy_global.h"
 #include "pe_type.h"
 #include "elf_type.h"
 #include "libinfo.h"
 #include "generalfiles_type.h"
+#include "libinfocache.h"
+#include "libgraph.h"
+#include "libpriorityclassifier.h"
 
 
 enum class PrivateScaner: unsigned char {
@@ -28,8 +32,35 @@ class DEPLOYSHARED_EXPORT DependenciesScanner {
 
 private:
 
-    QMultiHash<QString, QString> _EnvLibs;
-    QHash<QString, LibInfo> _scanedLibs;
+    /**
+     * @brief The EnvLib struct is record of the environment index.
+     *  The platform is read from the header of file and the priority is computed once while building the index.
+     */
+    struct EnvLib {
+        QString dir;
+        QString name;
+        Platform platform = UnknownPlatform;
+        LibPriority priority = NotFile;
+
+        QString fullPath() const;
+    };
+
+    /**
+     * @brief _EnvLibs This is index of the environment libraries (key - upper-cased file name).
+     *  Candidates of each name are saved in order of the environment.
+     */
+    QHash<QString, QVector<EnvLib>> _EnvLibs;
+    LibGraph _graph;
+
+    /**
+     * @brief _parsedLibs This is thread-safe cache of the parsed files (key - path to file).
+     * @note Use only with the _parsedLibsLock.
+     */
+    mutable QHash<QString, LibInfo> _parsedLibs;
+    mutable QReadWriteLock _parsedLibsLock;
+
+    LibInfoCache _cache;
+    LibPriorityClassifier _priorities;
 
     PE _peScaner;
     ELF _elfScaner;
@@ -37,9 +68,53 @@ private:
 
     PrivateScaner getScaner(const QString& lib) const;
 
-    QMultiMap<LibPriority, LibInfo> getLibsFromEnvirement(const QString& libName) const;
-
-    void recursiveDep(LibInfo& lib, QSet<LibInfo> &res, QSet<QString> &libStack);
+    /**
+     * @brief getEnvCandidates This method returns the environment libraries with the name and the platform.
+     *  If the environment has no libraries with the name then the library is found in the cache of the dynamic linker.
+     *  The system libraries (if the deploySystem option is disabled) and the ignored libraries are skipped.
+     * @param libName This is name of the library.
+     * @param platform This is required platform.
+     * @return list of the candidates sorted by priority.
+     */
+    QVector<EnvLib> getEnvCandidates(const QString& libName, Platform platform) const;
+
+    /**
+     * @brief getCachedLib This method finds the library in the cache of the dynamic linker.
+     *  Used for the libraries that are not exists in the environment.
+     * @param libName This is name of the library.
+     * @param platform This is required platform.
+     * @return list with the found library or empty list.
+     */
+    QVector<EnvLib> getCachedLib(const QString& libName, Platform platform) const;
+
+    /**
+     * @brief getLibFromEnvirement This method finds the best library from the environment.
+     *  Only candidates returned by the getEnvCandidates method are parsed.
+     * @param libName This is name of the library.
+     * @param platform This is required platform.
+     * @param info This is information of the found library.
+     * @return true if the library is found.
+     */
+    bool getLibFromEnvirement(const QString& libName, Platform platform, LibInfo& info) const;
+
+    /**
+     * @brief getPlatform This method reads the platform of file from the header only.
+     */
+    Platform getPlatform(const QString& file) const;
+
+    /**
+     * @brief parseLib This is thread-safe wraper of the fillLibInfo method. Each file will be parsed only once.
+     * @param file This is path to file.
+     * @param info This is result information.
+     * @return true if the information extracted successful.
+     */
+    bool parseLib(const QString& file, LibInfo& info) const;
+
+    /**
+     * @brief resolve This method finds the dependencies of all nodes that reachable from the root node.
+     * @param root This is id of the root node.
+     */
+    void resolve(LibGraph::NodeId root);
 
     void addToWinAPI(const QString& lib, QHash<WinAPI, QSet<QString> > &res);
 
@@ -48,9 +123,32 @@ public:
 
     void setEnvironment(const QStringList &env);
 
-    QSet<LibInfo> scan(const QString& path);
+    /**
+     * @brief scan This method returns all recursive dependencies of the file.
+     * @param path This is path to file.
+     * @return view of the dependencies graph. The view is valid until the clearScaned method is called.
+     */
+    LibGraphView scan(const QString& path);
+
+    /**
+     * @brief preScan This method parses the dependencies tree of all files on the pool of worker threads (see the jobs option).
+     *  The scan method uses the parsed data so the result of the scan method not depends on the count of threads.
+     * @param files This is list of the files for scanning.
+     */
+    void preScan(const QStringList& files);
     bool fillLibInfo(LibInfo& info ,const QString& file) const;
 
+    /**
+     * @brief initCache This method loads the persistent cache of the parsed libraries.
+     *  The noScanCache option disables the cache, the clearScanCache option removes all saved records.
+     */
+    void initCache();
+
+    /**
+     * @brief saveCache This method saves the persistent cache of the parsed libraries.
+     */
+    void saveCache();
+
     ~DependenciesScanner();
 
     friend class deploytest;
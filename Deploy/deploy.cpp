@@ -6,6 +6,7 @@
  */
 
 #include "configparser.h"
+#include "dependenciesscanner.h"
 #include "deploy.h"
 #include "extracter.h"
 #include "filemanager.h"
@@ -32,9 +33,15 @@ int Deploy::run() {
     _fileManager->loadDeployemendFiles(_paramsParser->config()->getTargetDir());
 
     if (!deploy()) {
+        _scaner->saveCache();
         return DeployError;
     }
 
+    _scaner->saveCache();
+    _fileManager->removeStaleFiles();
+    QuasarAppUtils::Params::log(_fileManager->copyBackend().report(),
+                                QuasarAppUtils::Info);
+
     if (!packing()) {
         _fileManager->saveDeploymendFiles(_paramsParser->config()->getTargetDir());
         return PackingError;
@@ -80,6 +87,7 @@ bool Deploy::prepare() {
         return false;
     }
 
+    _scaner->initCache();
     _extracter = new Extracter(_fileManager, _pluginParser, _paramsParser, _scaner);
 
     return true;
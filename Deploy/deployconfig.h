@@ -12,6 +12,7 @@
 #include "distromodule.h"
 #include "extra.h"
 #include "ignorerule.h"
+#include "ldcache.h"
 #include "qtdir.h"
 #include "targetinfo.h"
 
@@ -23,6 +24,26 @@ public:
      */
     int depchLimit = 0;
 
+    /**
+     * @brief jobs - count of worker threads. 0 - use count of cpu cores.
+     */
+    int jobs = 0;
+
+    /**
+     * @brief ioJobs - count of worker threads used for copying of files. 0 - use count of cpu cores.
+     */
+    int ioJobs = 0;
+
+    /**
+     * @brief zipLevel - compression level of the zip arhives (from 0 to 9).
+     */
+    int zipLevel = 6;
+
+    /**
+     * @brief debugPackage - package of the debug files created by the strip step (splitDebug option). Empty if the debug information is removed.
+     */
+    QString debugPackage;
+
     /**
      * @brief deployQml - enable or disable deploing of qml files.
      */
@@ -58,6 +79,11 @@ public:
      */
     Envirement envirement;
 
+    /**
+     * @brief ldCache - cache of the dynamic linker of the host system, used for find libraries that not exists in the envirement.
+     */
+    LdCache ldCache;
+
     /**
      * @brief reset config file to default
      */
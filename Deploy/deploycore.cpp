@@ -10,6 +10,7 @@
 #include "quasarapp.h"
 #include "pathutils.h"
 #include "pluginsparser.h"
+#include "ahocorasick.h"
 
 #include <QDebug>
 #include <QDir>
@@ -82,6 +83,10 @@ QtModuleEntry DeployCore::qtModuleEntries[] = {
     { QtWebViewModule, "webview", "QtXWebView", nullptr }
 };
 
+int DeployCore::qtModuleEntriesCount() {
+    return sizeof (qtModuleEntries) / sizeof (QtModuleEntry);
+}
+
 DeployCore::QtModule DeployCore::getQtModule(const QString& path) {
     auto Qt = DeployCore::isQtLib(path);
 
@@ -89,17 +94,38 @@ DeployCore::QtModule DeployCore::getQtModule(const QString& path) {
         return DeployCore::QtModule::NONE;
     }
 
-    int modulesCount = sizeof (qtModuleEntries) / sizeof (QtModuleEntry);
+    int index = qtModulesMatcher().firstMatch(QFileInfo(path).fileName());
+    if (index < 0) {
+        return DeployCore::QtModule::NONE;
+    }
+
+    return static_cast<DeployCore::QtModule>(qtModuleEntries[index].module);
+}
+
+const AhoCorasick &DeployCore::qtModulesMatcher() {
+    // the "QtX" placeholder is same as the "Qt[4,5,6]" regexp of the containsModule method.
+    static const AhoCorasick matcher = []() {
+        AhoCorasick result;
+        const int modulesCount = qtModuleEntriesCount();
+        const QStringList versions = {"Qt4", "Qt5", "Qt6", "Qt,"};
 
-    auto lIbName = QFileInfo(path).fileName();
+        for (int i = 0; i < modulesCount; ++i) {
+            const QString library = qtModuleEntries[i].libraryName;
+            if (!library.contains("QtX")) {
+                result.addPattern(library, i);
+                continue;
+            }
 
-    for (int i = 0; i < modulesCount; ++i) {
-        if (containsModule(qtModuleEntries[i].libraryName, lIbName)) {
-            return static_cast<DeployCore::QtModule>(qtModuleEntries[i].module);
+            for (const auto& version: versions) {
+                result.addPattern(QString(library).replace("QtX", version), i);
+            }
         }
-    }
 
-    return DeployCore::QtModule::NONE;
+        result.build();
+        return result;
+    }();
+
+    return matcher;
 }
 
 void DeployCore::addQtModule(DeployCore::QtModule &module, const QString &path) {
@@ -119,31 +145,6 @@ void DeployCore::addQtModule(DeployCore::QtModule &module, const QString &path)
 
 }
 
-LibPriority DeployCore::getLibPriority(const QString &lib) {
-
-    if (!QFileInfo(lib).isFile()) {
-        return NotFile;
-    }
-
-    if (isQtLib(lib)) {
-        return QtLib;
-    }
-
-    if (isExtraLib(lib)) {
-        return ExtraLib;
-    }
-
-    if (isAlienLib(lib)) {
-        return AlienLib;
-    }
-
-    if (isAllowedLib(lib)) {
-        return AllowedLib;
-    }
-
-    return SystemLib;
-}
-
 bool DeployCore::containsModule(const QString& moduleLibrary, const QString& lib) {
     QRegExp erfexp(QString(moduleLibrary).replace("QtX", "Qt[4,5,6]"));
     return lib.contains(erfexp);
@@ -167,7 +168,7 @@ RunMode DeployCore::getMode() {
         return RunMode::Deploy;
     }
 
-    if (C("clear") || C("force-clear")) {
+    if (C("clear") || C("force-clear") || C("clearScanCache")) {
         return RunMode::Clear;
     }
 
@@ -191,14 +192,24 @@ void DeployCore::help() {
                  " 'cqtdeployer -init multi' - for initialize multi package configuration"
                  " 'cqtdeployer -init single' - for initialize singel package configuration"},
                 {"help / h", "Shows help"},
-                {"clear", "Deletes deployable files of the previous session."},
+                {"clear", "Deletes deployable files of the previous session."
+                 " The list of the deployed files is saved into the .cqtdeployer.manifest file of the target directory."},
                 {"force-clear", "Deletes the destination directory before deployment."},
                 {"noStrip", "Skips strip step"},
+                {"splitDebug", "Moves the debug information of the deployed libraries into the separate .debug files instead of removing it by the strip step."
+                 " The .debug files are placed into the separate package (by default the name of this package is name of the default package with the Debug suffix)."
+                 " Use '-splitDebug myDebugPackage' for selecting the name of the debug package."},
                 {"noTranslations", "Skips the translations files. It doesn't work without qmake."},
                 {"noOverwrite", "Prevents replacing existing files."},
                 {"noCheckRPATH", "Disables automatic search of paths to qmake in executable files."},
                 {"noCheckPATH", "Disables automatic search of paths to qmake in system PATH."},
                 {"noRecursiveiIgnoreEnv", "Disables recursive ignore for ignoreEnv option."},
+                {"noScanCache", "Disables the persistent cache of the parsed libraries."},
+                {"clearScanCache", "Removes the persistent cache of the parsed libraries."
+                 " Example: 'cqtdeployer clearScanCache'"},
+                {"incremental", "Enables the incremental deploy. The files that not changed after the previous deploy are not copied again"
+                 " (the sizes and the modification times are compared) and files of the previous deploy that not deployed again are removed."
+                 " Use '-incremental strict' for comparing of the content hashes."},
                 {"v / version", "Shows compiled version"},
                 {"qif", "Create the QIF installer for deployment programm"
                         " You can specify the path to your own installer template. Examples: cqtdeployer -qif path/to/myCustom/qif."},
@@ -240,6 +251,13 @@ void DeployCore::help() {
                  " This option is case sensitive."},
                 {"-customScript [scriptCode]", "Insert extra code inTo All run script."},
                 {"-recursiveDepth [params]", "Sets the Depth of recursive search of libs and depth for ignoreEnv option (default 0)"},
+                {"-jobs [params]", "Sets the count of worker threads used for scanning of dependencies and for packing commands (by default it is count of the cpu cores)"},
+                {"-ioJobs [params]", "Sets the count of worker threads used for copying of files (by default it is count of the cpu cores)"},
+                {"-zipLevel [0-9]", "Sets the compression level of the zip arhives created by the zip option (by default it is 6)"},
+                {"-copyMode [params]", "Sets the first method of copying of files (auto, reflink, range, sendfile, qt, uring). If the method is not supported by the file system then next methods are used."
+                 " Order of methods: reflink (FICLONE), range (copy_file_range), sendfile, qt (QFile::copy)."
+                 " The uring method copies the batches of small files with io_uring and other files starting from reflink."
+                 " The kernel methods are available only on linux (by default it is auto)"},
                 {"-targetDir [params]", "Sets target directory(by default it is the path to the first deployable file)"},
                 {"-runScript [list,parems]", "forces cqtdeployer swap default run script to new from the arguments of option."
                  " This option copy all content from input file and insert all code into runScript.sh or .bat"
@@ -328,12 +346,19 @@ QStringList DeployCore::helpKeys() {
         "extraLibs",
         "extraPlugin",
         "recursiveDepth",
+        "jobs",
+        "ioJobs",
+        "copyMode",
         "targetDir",
         "targetPackage",
         "noStrip",
+        "splitDebug",
         "extractPlugins",
         "noTranslations",
         "noRecursiveiIgnoreEnv",
+        "noScanCache",
+        "clearScanCache",
+        "incremental",
         "qifFromSystem",
         "qmlOut",
         "libOut",
@@ -358,6 +383,7 @@ QStringList DeployCore::helpKeys() {
         "qifBanner",
         "qifLogo",
         "zip",
+        "zipLevel",
         "noQt",
         "homePage",
         "prefix",
@@ -370,11 +396,11 @@ QStringList DeployCore::helpKeys() {
 
 QStringList DeployCore::extractTranslation(const QSet<QString> &libs) {
     QSet<QString> res;
-    const size_t qtModulesCount = sizeof(qtModuleEntries) / sizeof(QtModuleEntry);
+    const auto &matcher = qtModulesMatcher();
 
     for (const auto &lib: libs) {
-        for (size_t i = 0; i < qtModulesCount; ++i) {
-            if (containsModule(qtModuleEntries[i].libraryName, lib) && qtModuleEntries[i].translation) {
+        for (int i : matcher.matches(lib)) {
+            if (qtModuleEntries[i].translation) {
                 res.insert(qtModuleEntries[i].translation);
             }
         }
@@ -114,6 +114,7 @@ enum class RunMode: int {
 
 class Extracter;
 class DeployConfig;
+class AhoCorasick;
 
 class DEPLOYSHARED_EXPORT DeployCore
 {
@@ -122,6 +123,13 @@ private:
     static QString getMSVCName(MSVCVersion msvc);
     static QString getMSVCVersion(MSVCVersion msvc);
 
+    /**
+     * @brief qtModulesMatcher This method returns matcher of the all library names from the qtModuleEntries table.
+     * Id of the pattern is index of the entry in the table. The matcher is built once on the first call.
+     * @return compiled matcher.
+     */
+    static const AhoCorasick& qtModulesMatcher();
+
 public:
     enum QtModule : quint64
     {
@@ -187,6 +195,7 @@ public:
 
 
     static QtModuleEntry qtModuleEntries[];
+    static int qtModuleEntriesCount();
 
     static const DeployConfig * _config;
 
@@ -216,8 +225,6 @@ public:
 
     static char getEnvSeparator();
 
-    static LibPriority getLibPriority(const QString &lib);
-
     /**
      * @brief containsModule This method compare lib name and module of qt.
      * @param muduleIndex this is name of module library
@@ -225,6 +232,12 @@ public:
      * @return true if library has some module that as muduleIndex
      */
     static bool containsModule(const QString &moduleLibrary, const QString &lib);
+
+    /**
+     * @brief getQtModule This method returns the first module of the qtModuleEntries table that matched with the library name.
+     * @param path This is path to qt library.
+     * @return qt module or NONE if the library is not qt library.
+     */
     static DeployCore::QtModule getQtModule(const QString& path);
     static void addQtModule(DeployCore::QtModule& module, const QString& path);
 
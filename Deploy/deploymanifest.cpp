@@ -0,0 +1,276 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "deploymanifest.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+const char Magic[] = "CQTMANIF";
+const int MagicSize = 8;
+const int HeaderSize = MagicSize + 4 + 4 + 8 + 8;
+// offset and size of path, origin and hash, sizes and modification times of the origin and the target.
+const int RecordSize = 6 * 4 + 4 * 8;
+
+template <typename T>
+void put(char *&data, T value) {
+    qToLittleEndian(value, data);
+    data += sizeof(T);
+}
+
+template <typename T>
+T take(const uchar *&data) {
+    T result = qFromLittleEndian<T>(data);
+    data += sizeof(T);
+    return result;
+}
+
+}
+
+DeployManifest::DeployManifest() {
+
+}
+
+QString DeployManifest::path(const QString &targetDir) {
+    return targetDir + "/.cqtdeployer.manifest";
+}
+
+DeployManifest::Entry DeployManifest::createEntry(const QString &source, const QString &target, bool withHash) {
+    QFileInfo sourceInfo(source);
+    QFileInfo targetInfo(target);
+
+    Entry entry;
+    entry.source = sourceInfo.absoluteFilePath();
+    entry.sourceSize = sourceInfo.size();
+    entry.sourceMtime = sourceInfo.lastModified().toMSecsSinceEpoch();
+    entry.size = targetInfo.size();
+    entry.mtime = targetInfo.lastModified().toMSecsSinceEpoch();
+
+    if (withHash) {
+        entry.hash = hash(source);
+    }
+
+    return entry;
+}
+
+DeployManifest::Entry DeployManifest::createEntry(const QFileInfo &target) {
+    Entry entry;
+    entry.size = target.size();
+    entry.mtime = target.lastModified().toMSecsSinceEpoch();
+
+    return entry;
+}
+
+QByteArray DeployManifest::hash(const QString &file) {
+    QFile f(file);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&f)) {
+        return {};
+    }
+
+    return hash.result();
+}
+
+bool DeployManifest::isUnchanged(const QString &source, const QString &target, bool strict) const {
+    auto entry = _entries.find(QFileInfo(target).absoluteFilePath());
+    if (entry == _entries.end()) {
+        return false;
+    }
+
+    return isUnchanged(entry.value(), source, target, strict);
+}
+
+bool DeployManifest::isUnchanged(const Entry &entry, const QString &source,
+                                 const QString &target, bool strict) {
+    QFileInfo sourceInfo(source);
+    QFileInfo targetInfo(target);
+
+    // the deployed file can be changed by the deploy (strip), so it is compared only with the record.
+    if (!targetInfo.isFile() ||
+            entry.source != sourceInfo.absoluteFilePath() ||
+            entry.sourceSize != sourceInfo.size() ||
+            entry.size != targetInfo.size() ||
+            entry.mtime != targetInfo.lastModified().toMSecsSinceEpoch()) {
+        return false;
+    }
+
+    if (!strict) {
+        return entry.sourceMtime == sourceInfo.lastModified().toMSecsSinceEpoch();
+    }
+
+    return entry.hash.size() && entry.hash == hash(source);
+}
+
+bool DeployManifest::contains(const QString &target) const {
+    return _entries.contains(target);
+}
+
+DeployManifest::Entry DeployManifest::value(const QString &target) const {
+    return _entries.value(target);
+}
+
+void DeployManifest::insert(const QString &target, const Entry &entry) {
+    _entries.insert(target, entry);
+}
+
+void DeployManifest::remove(const QString &target) {
+    _entries.remove(target);
+}
+
+void DeployManifest::movePaths(const QString &from, const QString &to) {
+    const QString prefix = from + "/";
+
+    QHash<QString, Entry> entries;
+    entries.reserve(_entries.size());
+    for (auto it = _entries.cbegin(); it != _entries.cend(); ++it) {
+        if (it.key() == from) {
+            entries.insert(to, it.value());
+        } else if (it.key().startsWith(prefix)) {
+            entries.insert(to + it.key().mid(from.size()), it.value());
+        } else {
+            entries.insert(it.key(), it.value());
+        }
+    }
+
+    _entries.swap(entries);
+}
+
+int DeployManifest::size() const {
+    return _entries.size();
+}
+
+void DeployManifest::clear() {
+    _entries.clear();
+}
+
+QStringList DeployManifest::files() const {
+    return _entries.keys();
+}
+
+bool DeployManifest::save(const QString &file, const QString &root) const {
+    const QDir rootDir(root);
+
+    QByteArray strings;
+    QByteArray records(RecordSize * _entries.size(), Qt::Uninitialized);
+    char *record = records.data();
+
+    auto addString = [&strings, &record](const QByteArray &value) {
+        put<quint32>(record, static_cast<quint32>(strings.size()));
+        put<quint32>(record, static_cast<quint32>(value.size()));
+        strings.append(value);
+    };
+
+    for (auto it = _entries.cbegin(); it != _entries.cend(); ++it) {
+        addString(rootDir.relativeFilePath(it.key()).toUtf8());
+        addString(it->source.toUtf8());
+        addString(it->hash);
+        put<qint64>(record, it->sourceSize);
+        put<qint64>(record, it->sourceMtime);
+        put<qint64>(record, it->size);
+        put<qint64>(record, it->mtime);
+    }
+
+    QByteArray header(HeaderSize, Qt::Uninitialized);
+    char *data = header.data();
+    memcpy(data, Magic, MagicSize);
+    data += MagicSize;
+    put<quint32>(data, Version);
+    put<quint32>(data, static_cast<quint32>(_entries.size()));
+    put<quint64>(data, static_cast<quint64>(HeaderSize + records.size()));
+    put<quint64>(data, static_cast<quint64>(strings.size()));
+
+    QSaveFile manifest(file);
+    if (!manifest.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    manifest.write(header);
+    manifest.write(records);
+    manifest.write(strings);
+
+    return manifest.commit();
+}
+
+bool DeployManifest::load(const QString &file, const QString &root) {
+    _entries.clear();
+
+    QFile manifest(file);
+    if (!manifest.open(QIODevice::ReadOnly) || manifest.size() < HeaderSize) {
+        return false;
+    }
+
+    const qint64 fileSize = manifest.size();
+    const uchar *begin = manifest.map(0, fileSize);
+    if (!begin) {
+        return false;
+    }
+
+    const uchar *data = begin;
+    if (memcmp(data, Magic, MagicSize) != 0) {
+        return false;
+    }
+    data += MagicSize;
+
+    const auto version = take<quint32>(data);
+    const auto count = take<quint32>(data);
+    const auto stringsOffset = take<quint64>(data);
+    const auto stringsSize = take<quint64>(data);
+
+    if (version != Version ||
+            stringsOffset != HeaderSize + static_cast<quint64>(count) * RecordSize ||
+            stringsOffset + stringsSize != static_cast<quint64>(fileSize)) {
+        return false;
+    }
+
+    const char *strings = reinterpret_cast<const char*>(begin + stringsOffset);
+    bool valid = true;
+    auto takeString = [&data, strings, stringsSize, &valid]() {
+        const auto offset = take<quint32>(data);
+        const auto size = take<quint32>(data);
+        if (static_cast<quint64>(offset) + size > stringsSize) {
+            valid = false;
+            return QByteArray();
+        }
+
+        return QByteArray(strings + offset, static_cast<int>(size));
+    };
+
+    const QDir rootDir(root);
+    _entries.reserve(static_cast<int>(count));
+    for (quint32 i = 0; i < count && valid; ++i) {
+        const QString path = QString::fromUtf8(takeString());
+
+        Entry entry;
+        entry.source = QString::fromUtf8(takeString());
+        entry.hash = takeString();
+        entry.sourceSize = take<qint64>(data);
+        entry.sourceMtime = take<qint64>(data);
+        entry.size = take<qint64>(data);
+        entry.mtime = take<qint64>(data);
+
+        _entries.insert(QDir::cleanPath(rootDir.absoluteFilePath(path)), entry);
+    }
+
+    if (!valid) {
+        _entries.clear();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,138 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef DEPLOYMANIFEST_H
+#define DEPLOYMANIFEST_H
+
+#include "deploy_global.h"
+
+#include <QByteArray>
+#include <QFileInfo>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The DeployManifest class contains information about the files deployed by the previous deploy.
+ * Each record is keyed by the absolute path of the deployed file and contains the origin of the file,
+ * so the incremental deploy can skip the files that not changed after the previous deploy.
+ *
+ * The manifest is saved into the target directory as the binary file with next layout (all numbers are little endian):
+ *  - header: magic "CQTMANIF", quint32 version, quint32 count of records, quint64 offset and quint64 size of the strings block.
+ *  - records: count of fixed size records (see the RecordSize), each contains offsets and sizes of
+ *  the path, origin and hash in the strings block and the qint64 sizes and modification times.
+ *  - strings: UTF-8 paths (relative to the target directory) and raw hashes.
+ * The fixed size records are read directly from the mapped file without parsing of the whole file.
+ */
+class DEPLOYSHARED_EXPORT DeployManifest
+{
+public:
+    struct Entry {
+        /// absolute path to the origin of the deployed file.
+        QString source;
+        qint64 sourceSize = 0;
+        qint64 sourceMtime = 0;
+
+        /// size of the deployed file.
+        qint64 size = 0;
+        /// modification time of the deployed file.
+        qint64 mtime = 0;
+
+        /// content hash of the origin, it is empty if the hash is not calculated.
+        QByteArray hash;
+    };
+
+    /// version of the binary format, the manifests with another version are ignored.
+    static const quint32 Version = 1;
+
+    DeployManifest();
+
+    /**
+     * @brief path This method returns path to manifest file of the target directory.
+     * @param targetDir This is target directory.
+     * @return path to manifest.
+     */
+    static QString path(const QString &targetDir);
+
+    /**
+     * @brief createEntry This method creates record of the deployed file.
+     * @param source This is origin of the file.
+     * @param target This is deployed file.
+     * @param withHash If this option is true then the content hash of the source will be calculated.
+     * @return record of the target.
+     */
+    static Entry createEntry(const QString &source, const QString &target, bool withHash);
+
+    /**
+     * @brief createEntry This method creates record of the file that created by deploy (directories, scripts).
+     * @param target This is deployed file. The size and the modification time are read from the cached information of file.
+     * @return record of the target without origin.
+     */
+    static Entry createEntry(const QFileInfo &target);
+
+    /**
+     * @brief hash This method returns content hash of the file.
+     * @param file This is path to file.
+     * @return hash or empty array if file can not be read.
+     */
+    static QByteArray hash(const QString &file);
+
+    /**
+     * @brief isUnchanged This method checks that the source and the target are not changed after previous deploy.
+     * @param source This is origin of the file.
+     * @param target This is deployed file.
+     * @param strict If this option is true then the content hash of the source is compared instead of the modification time.
+     * @return true if the target should not be copied again.
+     */
+    bool isUnchanged(const QString &source, const QString &target, bool strict) const;
+
+    /**
+     * @brief isUnchanged This is same as isUnchanged method but uses the selected record.
+     * @param entry This is record of the target.
+     */
+    static bool isUnchanged(const Entry &entry, const QString &source, const QString &target, bool strict);
+
+    bool contains(const QString &target) const;
+    Entry value(const QString &target) const;
+    void insert(const QString &target, const Entry &entry);
+    void remove(const QString &target);
+
+    /**
+     * @brief movePaths This method updates the records of files after moving of the folder.
+     * @param from This is old absolute path of the folder.
+     * @param to This is new absolute path of the folder.
+     */
+    void movePaths(const QString &from, const QString &to);
+    int size() const;
+    void clear();
+
+    /**
+     * @brief files This method returns absolute paths of all deployed files.
+     */
+    QStringList files() const;
+
+    /**
+     * @brief save This method writes manifest into the file. The file is replaced atomically.
+     * @param file This is path to manifest.
+     * @param root This is directory relative which the paths are saved.
+     * @return true if manifest saved.
+     */
+    bool save(const QString &file, const QString &root) const;
+
+    /**
+     * @brief load This method reads manifest from the file. All old records will be removed.
+     * @param file This is path to manifest.
+     * @param root This is directory relative which the paths are saved.
+     * @return true if manifest is loaded, false if file not exists, is damaged or has another version.
+     */
+    bool load(const QString &file, const QString &root);
+
+private:
+    QHash<QString, Entry> _entries;
+};
+
+#endif // DEPLOYMANIFEST_H
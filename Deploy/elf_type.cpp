@@ -6,100 +6,1011 @@
 //#
 
 #include "elf_type.h"
-#include <cmath>
+#include <algorithm>
+#include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QPair>
+#include <QSaveFile>
+#include <QVector>
+#include <QtEndian>
 #include <quasarapp.h>
 
+namespace {
+
+enum : quint32 {
+    PT_LOAD_TYPE    = 1,
+    PT_DYNAMIC_TYPE = 2
+};
+
+enum : qint64 {
+    DT_NULL_TAG    = 0,
+    DT_NEEDED_TAG  = 1,
+    DT_STRTAB_TAG  = 5,
+    DT_STRSZ_TAG   = 10,
+    DT_SONAME_TAG  = 14,
+    DT_RPATH_TAG   = 15,
+    DT_RUNPATH_TAG = 29
+};
+
+enum : quint32 {
+    SHT_PROGBITS_TYPE     = 1,
+    SHT_SYMTAB_TYPE       = 2,
+    SHT_RELA_TYPE         = 4,
+    SHT_NOTE_TYPE         = 7,
+    SHT_NOBITS_TYPE       = 8,
+    SHT_REL_TYPE          = 9,
+    SHT_DYNSYM_TYPE       = 11,
+    SHT_GROUP_TYPE        = 17,
+    SHT_SYMTAB_SHNDX_TYPE = 18
+};
+
+enum : quint64 {
+    SHF_ALLOC_FLAG     = 0x2,
+    SHF_INFO_LINK_FLAG = 0x40
+};
+
+enum : quint16 {
+    ET_EXEC_TYPE = 2,
+    ET_DYN_TYPE  = 3,
+
+    SHN_LORESERVE_INDEX = 0xff00
+};
+
+enum : quint16 {
+    EM_386_MACHINE     = 3,
+    EM_ARM_MACHINE     = 40,
+    EM_X86_64_MACHINE  = 62,
+    EM_AARCH64_MACHINE = 183
+};
+
+/**
+ * @brief The ElfImage class is read only view of the mapped elf file.
+ * All reads are checked with the bounds of file.
+ */
+class ElfImage {
+public:
+    ElfImage(const uchar *data, qint64 size):
+        _data(data), _size(size) {
+    }
+
+    bool init() {
+        if (_size < 52 || qstrncmp(reinterpret_cast<const char*>(_data), "\177ELF", 4) != 0) {
+            return false;
+        }
+
+        if (_data[4] != 1 && _data[4] != 2) {
+            return false;
+        }
+
+        if (_data[5] != 1 && _data[5] != 2) {
+            return false;
+        }
+
+        _is64 = _data[4] == 2;
+        _bigEndian = _data[5] == 2;
+
+        return !_is64 || _size >= 64;
+    }
+
+    bool is64() const {
+        return _is64;
+    }
+
+    bool isBigEndian() const {
+        return _bigEndian;
+    }
+
+    bool contains(quint64 offset, quint64 size) const {
+        return offset <= static_cast<quint64>(_size) &&
+                size <= static_cast<quint64>(_size) - offset;
+    }
+
+    template<typename T>
+    T read(quint64 offset) const {
+        if (!contains(offset, sizeof(T))) {
+            return 0;
+        }
+
+        if (_bigEndian) {
+            return qFromBigEndian<T>(_data + offset);
+        }
+
+        return qFromLittleEndian<T>(_data + offset);
+    }
+
+    quint64 readWord(quint64 offset) const {
+        if (_is64) {
+            return read<quint64>(offset);
+        }
+
+        return read<quint32>(offset);
+    }
+
+    QByteArray string(quint64 offset, quint64 limit) const {
+        if (offset >= limit || !contains(offset, 1)) {
+            return {};
+        }
+
+        limit = std::min(limit, static_cast<quint64>(_size));
+        auto begin = reinterpret_cast<const char*>(_data + offset);
+        return QByteArray(begin, static_cast<int>(qstrnlen(begin, static_cast<uint>(limit - offset))));
+    }
+
+private:
+    const uchar *_data = nullptr;
+    qint64 _size = 0;
+    bool _is64 = false;
+    bool _bigEndian = false;
+};
+
+template<typename T>
+void writeValue(uchar *dest, T value, bool bigEndian) {
+    if (bigEndian) {
+        qToBigEndian(value, dest);
+    } else {
+        qToLittleEndian(value, dest);
+    }
+}
+
+void writeWord(uchar *dest, quint64 value, bool is64, bool bigEndian) {
+    if (is64) {
+        writeValue<quint64>(dest, value, bigEndian);
+    } else {
+        writeValue<quint32>(dest, static_cast<quint32>(value), bigEndian);
+    }
+}
+
+bool isDebugSection(const QByteArray &name) {
+    return name.startsWith(".debug") || name.startsWith(".zdebug");
+}
+
+quint64 alignUp(quint64 value, quint64 align) {
+    if (align <= 1) {
+        return value;
+    }
+
+    return (value + align - 1) / align * align;
+}
+
+void appendPadding(QByteArray &data, quint64 base, quint64 align) {
+    const quint64 end = base + static_cast<quint64>(data.size());
+    data.append(QByteArray(static_cast<int>(alignUp(end, align) - end), '\0'));
+}
+
+// the crc32 used by the .gnu_debuglink section (same as the zlib crc32).
+quint32 crc32(const QByteArray &data) {
+    static const QVector<quint32> table = [] {
+        QVector<quint32> result(256);
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1)? (crc >> 1) ^ 0xEDB88320u: crc >> 1;
+            }
+            result[static_cast<int>(i)] = crc;
+        }
+        return result;
+    }();
+
+    quint32 crc = 0xFFFFFFFFu;
+    for (char byte: data) {
+        crc = table[static_cast<int>((crc ^ static_cast<uchar>(byte)) & 0xFF)] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xFFFFFFFFu;
+}
+
+struct ProgramHeader {
+    quint32 type = 0;
+    quint64 offset = 0;
+    quint64 vaddr = 0;
+    quint64 filesz = 0;
+};
+
+Platform platformOf(quint16 machine, bool is64) {
+    switch (machine) {
+    case EM_ARM_MACHINE:
+        return (is64)? Unix_ARM_64: Unix_ARM_32;
+    case EM_AARCH64_MACHINE:
+        return Unix_ARM_64;
+    case EM_386_MACHINE:
+    case EM_X86_64_MACHINE:
+        return (is64)? Unix_x86_64: Unix_x86_32;
+    default:
+        return UnknownPlatform;
+    }
+}
+
+bool addressToOffset(const QVector<ProgramHeader>& loads, quint64 address, quint64 &offset) {
+    for (const auto &load: loads) {
+        if (address >= load.vaddr && address - load.vaddr < load.filesz) {
+            offset = load.offset + (address - load.vaddr);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
+
 ELF::ELF()
 {
 
 }
 
-QByteArrayList ELF::getDynamicString(ElfReader& reader) const {
-    auto headers = reader.readHeaders();
+bool ELF::readDynamic(const QString &lib, ElfDynamicInfo &dynamic) const {
+    dynamic = {};
+
+    QFile file(lib);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 fileSize = file.size();
+    const uchar* data = file.map(0, fileSize);
+    if (!data) {
+        return false;
+    }
+
+    ElfImage image(data, fileSize);
+    if (!image.init()) {
+        return false;
+    }
+
+    const bool is64 = image.is64();
+
+    dynamic.platform = platformOf(image.read<quint16>(18), is64);
+    if (dynamic.platform == UnknownPlatform) {
+        return false;
+    }
+
+    const quint64 phoff = image.readWord((is64)? 32: 28);
+    const quint16 phentsize = image.read<quint16>((is64)? 54: 42);
+    const quint16 phnum = image.read<quint16>((is64)? 56: 44);
+
+    // the truncated file is not valid elf file even if the loader could read the first segments.
+    if (phnum && (phentsize < ((is64)? 56: 32) ||
+                  !image.contains(phoff, static_cast<quint64>(phnum) * phentsize))) {
+        return false;
+    }
+
+    QVector<ProgramHeader> loads;
+    ProgramHeader dynamicHeader;
+
+    for (quint16 i = 0; i < phnum; ++i) {
+        const quint64 entry = phoff + static_cast<quint64>(i) * phentsize;
+
+        ProgramHeader header;
+        header.type = image.read<quint32>(entry);
+        header.offset = image.readWord(entry + ((is64)? 8: 4));
+        header.vaddr = image.readWord(entry + ((is64)? 16: 8));
+        header.filesz = image.readWord(entry + ((is64)? 32: 16));
+
+        if (header.type == PT_LOAD_TYPE) {
+            loads.push_back(header);
+        } else if (header.type == PT_DYNAMIC_TYPE) {
+            dynamicHeader = header;
+        }
+    }
+
+    // static binaries do not have the dynamic section.
+    if (dynamicHeader.type != PT_DYNAMIC_TYPE) {
+        return true;
+    }
+
+    if (!image.contains(dynamicHeader.offset, dynamicHeader.filesz)) {
+        return false;
+    }
+
+    const quint64 dynSize = (is64)? 16: 8;
+    quint64 strtabAddress = 0;
+    quint64 strtabSize = 0;
+    QVector<quint64> needed;
+    qint64 soname = -1, rpath = -1, runpath = -1;
+
+    for (quint64 entry = dynamicHeader.offset;
+         entry - dynamicHeader.offset + dynSize <= dynamicHeader.filesz;
+         entry += dynSize) {
+
+        const qint64 tag = (is64)? image.read<qint64>(entry): image.read<qint32>(entry);
+        const quint64 value = image.readWord(entry + dynSize / 2);
+
+        if (tag == DT_NULL_TAG) {
+            break;
+        }
+
+        switch (tag) {
+        case DT_NEEDED_TAG: needed.push_back(value); break;
+        case DT_STRTAB_TAG: strtabAddress = value; break;
+        case DT_STRSZ_TAG: strtabSize = value; break;
+        case DT_SONAME_TAG: soname = static_cast<qint64>(value); break;
+        case DT_RPATH_TAG: rpath = static_cast<qint64>(value); break;
+        case DT_RUNPATH_TAG: runpath = static_cast<qint64>(value); break;
+        default: break;
+        }
+    }
 
-    for (const auto &sectionHeader : qAsConst(headers.sectionHeaders)) {
-        if (sectionHeader.name == ".dynstr") {
-            auto arr = reader.readSection(sectionHeader.name).split(0);
-            return arr;
+    quint64 strtab = 0;
+    if (!addressToOffset(loads, strtabAddress, strtab)) {
+        return needed.isEmpty();
+    }
+
+    if (!image.contains(strtab, strtabSize)) {
+        return false;
+    }
+
+    const quint64 strtabEnd = strtab + strtabSize;
+
+    for (quint64 offset: qAsConst(needed)) {
+        auto name = image.string(strtab + offset, strtabEnd);
+        if (name.size()) {
+            dynamic.needed.push_back(name);
         }
     }
 
-    return {};
+    if (soname >= 0)
+        dynamic.soname = image.string(strtab + static_cast<quint64>(soname), strtabEnd);
+
+    if (rpath >= 0)
+        dynamic.rpath = image.string(strtab + static_cast<quint64>(rpath), strtabEnd);
+
+    if (runpath >= 0)
+        dynamic.runpath = image.string(strtab + static_cast<quint64>(runpath), strtabEnd);
+
+    return true;
+}
+
+Platform ELF::getPlatform(const QString &lib) const {
+    QFile file(lib);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return UnknownPlatform;
+    }
+
+    const QByteArray header = file.read(64);
+    ElfImage image(reinterpret_cast<const uchar*>(header.constData()), header.size());
+    if (!image.init()) {
+        return UnknownPlatform;
+    }
+
+    return platformOf(image.read<quint16>(18), image.is64());
+}
+
+bool ELF::isElf(const QString &lib) const {
+    QFile file(lib);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QByteArray header = file.read(64);
+    ElfImage image(reinterpret_cast<const uchar*>(header.constData()), header.size());
+    return image.init();
 }
 
-int ELF::getVersionOfTag(const QByteArray& tag, QByteArray& source) const {
-    auto versions = source.replace(tag, "").split('.');
+bool ELF::readSections(const QString &lib, QVector<ElfSection> &sections) const {
+    sections.clear();
+
+    QFile file(lib);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 fileSize = file.size();
+    const uchar* data = file.map(0, fileSize);
+    if (!data) {
+        return false;
+    }
+
+    ElfImage image(data, fileSize);
+    if (!image.init()) {
+        return false;
+    }
+
+    const bool is64 = image.is64();
+
+    const quint64 shoff = image.readWord((is64)? 40: 32);
+    const quint16 shentsize = image.read<quint16>((is64)? 58: 46);
+    const quint16 shnum = image.read<quint16>((is64)? 60: 48);
+    const quint16 shstrndx = image.read<quint16>((is64)? 62: 50);
+
+    const quint64 headerSize = (is64)? 64: 40;
+    if (shnum && (shentsize < headerSize || !image.contains(shoff, static_cast<quint64>(shnum) * shentsize))) {
+        return false;
+    }
+
+    QVector<quint32> names;
+    sections.reserve(shnum);
+    names.reserve(shnum);
+
+    for (quint16 i = 0; i < shnum; ++i) {
+        const quint64 entry = shoff + static_cast<quint64>(i) * shentsize;
 
-    int step = static_cast<int>(pow(100, 4));
-    int ver = 0;
-    auto it = versions.begin();
+        ElfSection section;
+        names.push_back(image.read<quint32>(entry));
+        section.type = image.read<quint32>(entry + 4);
+        section.flags = image.readWord(entry + 8);
+        section.offset = image.readWord(entry + ((is64)? 24: 16));
+        section.size = image.readWord(entry + ((is64)? 32: 20));
 
-    while (it != versions.end()) {
-        bool ok;
-        int curVer = it->toInt(&ok);
+        sections.push_back(section);
+    }
 
-        if (!ok) {
-            return -1;
+    if (static_cast<int>(shstrndx) < sections.size()) {
+        const auto &strtab = sections[shstrndx];
+        const quint64 strtabEnd = strtab.offset + strtab.size;
+
+        for (int i = 0; i < sections.size(); ++i) {
+            sections[i].name = image.string(strtab.offset + names[i], strtabEnd);
         }
-        ver += curVer * step;
-        step /= 100;
-        it++;
     }
 
-    return ver;
+    return true;
 }
 
-bool ELF::getLibInfo(const QString &lib, LibInfo &info) const {
-    ElfReader reader(lib);
+bool ELF::isStrippable(const QString &lib) const {
+    QVector<ElfSection> sections;
+    if (!readSections(lib, sections)) {
+        return false;
+    }
+
+    for (const auto &section: qAsConst(sections)) {
+        if (section.flags & SHF_ALLOC_FLAG) {
+            continue;
+        }
 
-    auto headers = reader.readHeaders();
+        if (section.type == SHT_SYMTAB_TYPE || isDebugSection(section.name)) {
+            return true;
+        }
+    }
 
-    if (headers.elfmachine == ElfMachine::Elf_EM_ARM) {
+    return false;
+}
 
-        if (headers.elfclass == ElfClass::Elf_ELFCLASS32) {
-            info.setPlatform(Unix_ARM_32);
+ELF::StripResult ELF::strip(const QString &lib) const {
+    return stripPrivate(lib, {}, 0);
+}
 
-        } else {
-            info.setPlatform(Unix_ARM_64);
+ELF::StripResult ELF::splitDebug(const QString &lib, const QString &debugFile) const {
+    QByteArray debugData;
+    {
+        QFile file(lib);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return StripFailed;
         }
 
-    } else if (headers.elfmachine == ElfMachine::Elf_EM_X86_64 ||
-               headers.elfmachine == ElfMachine::Elf_EM_386) {
+        const qint64 fileSize = file.size();
+        const uchar* data = file.map(0, fileSize);
+        if (!data) {
+            return StripNotSupported;
+        }
 
-        if (headers.elfclass == ElfClass::Elf_ELFCLASS32) {
-            info.setPlatform(Unix_x86_32);
+        ElfImage image(data, fileSize);
+        if (!image.init()) {
+            return StripNotSupported;
+        }
 
-        } else {
-            info.setPlatform(Unix_x86_64);
+        const bool is64 = image.is64();
+        const bool bigEndian = image.isBigEndian();
+
+        const quint16 type = image.read<quint16>(16);
+        const quint16 ehsize = image.read<quint16>((is64)? 52: 40);
+        const quint64 shoff = image.readWord((is64)? 40: 32);
+        const quint16 shentsize = image.read<quint16>((is64)? 58: 46);
+        const quint16 shnum = image.read<quint16>((is64)? 60: 48);
+        const quint16 shstrndx = image.read<quint16>((is64)? 62: 50);
+
+        if ((type != ET_EXEC_TYPE && type != ET_DYN_TYPE) || !shnum || shstrndx >= shnum ||
+                shentsize < ((is64)? 64: 40) || !image.contains(0, ehsize) ||
+                !image.contains(shoff, static_cast<quint64>(shnum) * shentsize)) {
+            return StripNotSupported;
         }
 
-    } else {
-        info.setPlatform(UnknownPlatform);
-        return false;
+        // the debug file contains the same section headers, so the indexes of the .symtab stay valid.
+        // The loaded sections (except notes with the build id) do not contain data, the program headers are dropped.
+        debugData.append(reinterpret_cast<const char*>(data), ehsize);
+        QByteArray headers;
+
+        for (quint16 i = 0; i < shnum; ++i) {
+            QByteArray header(reinterpret_cast<const char*>(data + shoff + static_cast<quint64>(i) * shentsize), shentsize);
+            uchar *raw = reinterpret_cast<uchar*>(header.data());
+
+            const quint64 entry = shoff + static_cast<quint64>(i) * shentsize;
+            const quint32 sectionType = image.read<quint32>(entry + 4);
+            const quint64 flags = image.readWord(entry + 8);
+            const quint64 offset = image.readWord(entry + ((is64)? 24: 16));
+            const quint64 size = image.readWord(entry + ((is64)? 32: 20));
+            const quint64 align = image.readWord(entry + ((is64)? 48: 32));
+
+            if (i && sectionType != SHT_NOBITS_TYPE &&
+                    (!(flags & SHF_ALLOC_FLAG) || sectionType == SHT_NOTE_TYPE)) {
+                if (!image.contains(offset, size)) {
+                    return StripNotSupported;
+                }
+
+                appendPadding(debugData, 0, align);
+                writeWord(raw + ((is64)? 24: 16), static_cast<quint64>(debugData.size()), is64, bigEndian);
+                debugData.append(reinterpret_cast<const char*>(data + offset), static_cast<int>(size));
+            } else if (i) {
+                writeValue<quint32>(raw + 4, SHT_NOBITS_TYPE, bigEndian);
+                writeWord(raw + ((is64)? 24: 16), static_cast<quint64>(debugData.size()), is64, bigEndian);
+            }
+
+            headers.append(header);
+        }
+
+        appendPadding(debugData, 0, (is64)? 8: 4);
+        uchar *elfHeader = reinterpret_cast<uchar*>(debugData.data());
+        writeWord(elfHeader + ((is64)? 32: 28), 0, is64, bigEndian);
+        writeValue<quint16>(elfHeader + ((is64)? 56: 44), 0, bigEndian);
+        writeWord(elfHeader + ((is64)? 40: 32), static_cast<quint64>(debugData.size()), is64, bigEndian);
+        debugData.append(headers);
     }
 
-    if (!QuasarAppUtils::Params::isEndable("noCheckRPATH")) {
-        auto dynStr = getDynamicString(reader);
+    if (!QDir().mkpath(QFileInfo(debugFile).absolutePath())) {
+        return StripFailed;
+    }
+
+    QSaveFile debug(debugFile);
+    if (!debug.open(QIODevice::WriteOnly) ||
+            debug.write(debugData) != debugData.size() ||
+            !debug.commit()) {
+        return StripFailed;
+    }
+
+    auto result = stripPrivate(lib, QFileInfo(debugFile).fileName().toUtf8(), crc32(debugData));
+    if (result != StripDone) {
+        QFile::remove(debugFile);
+    }
+
+    return result;
+}
+
+ELF::StripResult ELF::stripPrivate(const QString &lib, const QByteArray &debugLink, quint32 crc) const {
+    QFile file(lib);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return StripFailed;
+    }
+
+    const qint64 fileSize = file.size();
+    const uchar* data = file.map(0, fileSize);
+    if (!data) {
+        return StripNotSupported;
+    }
+
+    ElfImage image(data, fileSize);
+    if (!image.init()) {
+        return StripNotSupported;
+    }
+
+    const bool is64 = image.is64();
+    const bool bigEndian = image.isBigEndian();
+
+    // the relocatable objects contain the section groups and the relocations of the debug sections.
+    const quint16 type = image.read<quint16>(16);
+    if (type != ET_EXEC_TYPE && type != ET_DYN_TYPE) {
+        return StripNotSupported;
+    }
+
+    const quint16 ehsize = image.read<quint16>((is64)? 52: 40);
+    const quint64 phoff = image.readWord((is64)? 32: 28);
+    const quint16 phentsize = image.read<quint16>((is64)? 54: 42);
+    const quint16 phnum = image.read<quint16>((is64)? 56: 44);
+    const quint64 shoff = image.readWord((is64)? 40: 32);
+    const quint16 shentsize = image.read<quint16>((is64)? 58: 46);
+    const quint16 shnum = image.read<quint16>((is64)? 60: 48);
+    const quint16 shstrndx = image.read<quint16>((is64)? 62: 50);
+
+    const quint64 sectionHeaderSize = (is64)? 64: 40;
+    const quint64 programHeaderSize = (is64)? 56: 32;
+
+    if (!shnum) {
+        // zero count with the table means that the count of sections is saved in the first section header.
+        return (shoff)? StripNotSupported: StripDone;
+    }
+
+    if (shstrndx >= shnum || shentsize < sectionHeaderSize ||
+            !image.contains(shoff, static_cast<quint64>(shnum) * shentsize) ||
+            (phnum && (phentsize < programHeaderSize ||
+                       !image.contains(phoff, static_cast<quint64>(phnum) * phentsize)))) {
+        return StripNotSupported;
+    }
+
+    // all data used by the loader stays on the same place.
+    quint64 fixedEnd = std::max<quint64>(ehsize, phoff + static_cast<quint64>(phnum) * phentsize);
+    for (quint16 i = 0; i < phnum; ++i) {
+        const quint64 entry = phoff + static_cast<quint64>(i) * phentsize;
+        const quint64 offset = image.readWord(entry + ((is64)? 8: 4));
+        const quint64 filesz = image.readWord(entry + ((is64)? 32: 16));
+        fixedEnd = std::max(fixedEnd, offset + filesz);
+    }
+
+    if (!image.contains(0, fixedEnd)) {
+        return StripNotSupported;
+    }
+
+    struct Section {
+        quint64 header = 0;
+        quint32 name = 0;
+        quint32 type = 0;
+        quint64 flags = 0;
+        quint64 offset = 0;
+        quint64 size = 0;
+        quint32 link = 0;
+        quint32 info = 0;
+        quint64 align = 0;
+        quint64 entsize = 0;
+        bool removed = false;
+    };
+
+    QVector<Section> sections(shnum);
+    for (quint16 i = 0; i < shnum; ++i) {
+        Section &section = sections[i];
+        section.header = shoff + static_cast<quint64>(i) * shentsize;
+        section.name = image.read<quint32>(section.header);
+        section.type = image.read<quint32>(section.header + 4);
+        section.flags = image.readWord(section.header + 8);
+        section.offset = image.readWord(section.header + ((is64)? 24: 16));
+        section.size = image.readWord(section.header + ((is64)? 32: 20));
+        section.link = image.read<quint32>(section.header + ((is64)? 40: 24));
+        section.info = image.read<quint32>(section.header + ((is64)? 44: 28));
+        section.align = image.readWord(section.header + ((is64)? 48: 32));
+        section.entsize = image.readWord(section.header + ((is64)? 56: 36));
+
+        if (section.type == SHT_GROUP_TYPE || section.type == SHT_SYMTAB_SHNDX_TYPE) {
+            return StripNotSupported;
+        }
+
+        if (section.type != SHT_NOBITS_TYPE && section.offset < fixedEnd &&
+                section.offset + section.size > fixedEnd) {
+            return StripNotSupported;
+        }
+    }
+
+    const Section &shstrtab = sections[shstrndx];
+    const quint64 shstrtabEnd = shstrtab.offset + shstrtab.size;
+    if (shstrtab.type == SHT_NOBITS_TYPE || !image.contains(shstrtab.offset, shstrtab.size)) {
+        return StripNotSupported;
+    }
+
+    auto nameOf = [&image, &shstrtab, shstrtabEnd](const Section& section) {
+        return image.string(shstrtab.offset + section.name, shstrtabEnd);
+    };
+
+    // the .symtab, the .debug* sections and the string table of the .symtab are removed (same as strip --strip-unneeded).
+    int removedCount = 0;
+    for (int i = 1; i < sections.size(); ++i) {
+        Section &section = sections[i];
+        if (section.flags & SHF_ALLOC_FLAG || i == shstrndx) {
+            continue;
+        }
+
+        const QByteArray name = nameOf(section);
+        if (section.type == SHT_SYMTAB_TYPE || isDebugSection(name) ||
+                (debugLink.size() && name == ".gnu_debuglink")) {
+            section.removed = true;
+            ++removedCount;
+        }
+    }
+
+    for (int i = 1; i < sections.size(); ++i) {
+        const Section &section = sections[i];
+        if (section.type != SHT_SYMTAB_TYPE || !section.removed ||
+                section.link == 0 || section.link >= static_cast<quint32>(sections.size())) {
+            continue;
+        }
 
-        for (auto i = dynStr.rbegin(); i != dynStr.rend(); ++i) {
+        Section &strtab = sections[static_cast<int>(section.link)];
+        if (strtab.removed || strtab.flags & SHF_ALLOC_FLAG ||
+                section.link == shstrndx) {
+            continue;
+        }
 
-            if (i->contains("end_")) {
+        bool used = false;
+        for (int j = 1; j < sections.size(); ++j) {
+            if (!sections[j].removed && sections[j].link == section.link) {
+                used = true;
                 break;
             }
+        }
+
+        if (!used) {
+            strtab.removed = true;
+            ++removedCount;
+        }
+    }
+
+    // the relocations of the removed sections.
+    for (int i = 1; i < sections.size(); ++i) {
+        Section &section = sections[i];
+        if (!section.removed && !(section.flags & SHF_ALLOC_FLAG) &&
+                (section.type == SHT_REL_TYPE || section.type == SHT_RELA_TYPE) &&
+                section.info < static_cast<quint32>(sections.size()) &&
+                sections[static_cast<int>(section.info)].removed) {
+            section.removed = true;
+            ++removedCount;
+        }
+    }
+
+    if (!removedCount && debugLink.isEmpty()) {
+        return StripDone;
+    }
+
+    QVector<quint32> newIndexes(sections.size(), 0);
+    quint32 count = 0;
+    for (int i = 0; i < sections.size(); ++i) {
+        if (!sections[i].removed) {
+            newIndexes[i] = count++;
+        }
+    }
+
+    auto remap = [&sections, &newIndexes](quint32 index, quint32 &result) {
+        if (index == 0 || index >= SHN_LORESERVE_INDEX) {
+            result = index;
+            return true;
+        }
+
+        if (index >= static_cast<quint32>(sections.size()) || sections[static_cast<int>(index)].removed) {
+            return false;
+        }
+
+        result = newIndexes[static_cast<int>(index)];
+        return true;
+    };
+
+    // the names of the removed sections are dropped from the section names table if it is not used by the loader.
+    const bool rebuildNames = shstrtab.offset >= fixedEnd;
+    if (!rebuildNames && debugLink.size()) {
+        return StripNotSupported;
+    }
+    QByteArray names(1, '\0');
+    QHash<QByteArray, quint32> nameOffsets;
+    QVector<quint32> newNames(sections.size(), 0);
+    for (int i = 0; i < sections.size(); ++i) {
+        if (sections[i].removed) {
+            continue;
+        }
+
+        if (!rebuildNames) {
+            newNames[i] = sections[i].name;
+            continue;
+        }
+
+        const QByteArray name = nameOf(sections[i]);
+        if (name.isEmpty()) {
+            continue;
+        }
+
+        auto it = nameOffsets.find(name);
+        if (it == nameOffsets.end()) {
+            it = nameOffsets.insert(name, static_cast<quint32>(names.size()));
+            names.append(name);
+            names.append('\0');
+        }
+
+        newNames[i] = it.value();
+    }
+
+    const quint32 debugLinkName = static_cast<quint32>(names.size());
+    if (debugLink.size()) {
+        names.append(".gnu_debuglink");
+        names.append('\0');
+    }
+
+    // the moved sections are placed after the loaded data in the original order.
+    QVector<int> moved;
+    for (int i = 1; i < sections.size(); ++i) {
+        const Section &section = sections[i];
+        if (!section.removed && section.type != SHT_NOBITS_TYPE && section.offset >= fixedEnd) {
+            moved.push_back(i);
+        }
+    }
+
+    std::sort(moved.begin(), moved.end(), [&sections](int left, int right) {
+        return sections[left].offset < sections[right].offset;
+    });
+
+    QVector<quint64> newOffsets(sections.size(), 0);
+    QVector<quint64> newSizes(sections.size(), 0);
+    for (int i = 0; i < sections.size(); ++i) {
+        newOffsets[i] = sections[i].offset;
+        newSizes[i] = sections[i].size;
+    }
+
+    QByteArray tail;
+    for (int i: qAsConst(moved)) {
+        const Section &section = sections[i];
+        const quint64 offset = alignUp(fixedEnd + static_cast<quint64>(tail.size()), section.align);
+        tail.append(QByteArray(static_cast<int>(offset - fixedEnd - static_cast<quint64>(tail.size())), '\0'));
+
+        newOffsets[i] = offset;
+        if (i == shstrndx && rebuildNames) {
+            tail.append(names);
+            newSizes[i] = static_cast<quint64>(names.size());
+        } else {
+            if (!image.contains(section.offset, section.size)) {
+                return StripNotSupported;
+            }
+
+            tail.append(reinterpret_cast<const char*>(data + section.offset), static_cast<int>(section.size));
+        }
+    }
+
+    // the .gnu_debuglink contains the name of the debug file aligned to 4 bytes and the crc32 of the debug file.
+    quint64 debugLinkOffset = 0;
+    QByteArray debugLinkData;
+    if (debugLink.size()) {
+        debugLinkData = debugLink;
+        debugLinkData.append('\0');
+        appendPadding(debugLinkData, 0, 4);
+        QByteArray crcData(4, '\0');
+        writeValue<quint32>(reinterpret_cast<uchar*>(crcData.data()), crc, bigEndian);
+        debugLinkData.append(crcData);
+
+        appendPadding(tail, fixedEnd, 4);
+        debugLinkOffset = fixedEnd + static_cast<quint64>(tail.size());
+        tail.append(debugLinkData);
+    }
+
+    const quint64 newShoff = alignUp(fixedEnd + static_cast<quint64>(tail.size()), (is64)? 8: 4);
+    tail.append(QByteArray(static_cast<int>(newShoff - fixedEnd - static_cast<quint64>(tail.size())), '\0'));
+
+    for (int i = 0; i < sections.size(); ++i) {
+        const Section &section = sections[i];
+        if (section.removed) {
+            continue;
+        }
+
+        quint32 link = 0, info = section.info;
+        if (!remap(section.link, link)) {
+            return StripNotSupported;
+        }
+
+        if ((section.flags & SHF_INFO_LINK_FLAG || section.type == SHT_REL_TYPE || section.type == SHT_RELA_TYPE) &&
+                !remap(section.info, info)) {
+            return StripNotSupported;
+        }
+
+        QByteArray header(reinterpret_cast<const char*>(data + section.header), shentsize);
+        uchar *raw = reinterpret_cast<uchar*>(header.data());
+        writeValue<quint32>(raw, newNames[i], bigEndian);
+        writeWord(raw + ((is64)? 24: 16), newOffsets[i], is64, bigEndian);
+        writeWord(raw + ((is64)? 32: 20), newSizes[i], is64, bigEndian);
+        writeValue<quint32>(raw + ((is64)? 40: 24), link, bigEndian);
+        writeValue<quint32>(raw + ((is64)? 44: 28), info, bigEndian);
+
+        tail.append(header);
+    }
+
+    if (debugLink.size()) {
+        QByteArray header(shentsize, '\0');
+        uchar *raw = reinterpret_cast<uchar*>(header.data());
+        writeValue<quint32>(raw, debugLinkName, bigEndian);
+        writeValue<quint32>(raw + 4, SHT_PROGBITS_TYPE, bigEndian);
+        writeWord(raw + ((is64)? 24: 16), debugLinkOffset, is64, bigEndian);
+        writeWord(raw + ((is64)? 32: 20), static_cast<quint64>(debugLinkData.size()), is64, bigEndian);
+        writeWord(raw + ((is64)? 48: 32), 4, is64, bigEndian);
+
+        tail.append(header);
+        ++count;
+    }
+
+    // the section indexes of the dynamic symbols are changed if some removed section is placed before them.
+    QVector<QPair<quint64, QByteArray>> patches;
+    for (int i = 1; i < sections.size(); ++i) {
+        const Section &section = sections[i];
+        const quint64 symbolSize = (is64)? 24: 16;
+        const quint64 shndxOffset = (is64)? 6: 14;
+        if (section.removed || section.type != SHT_DYNSYM_TYPE || !image.contains(section.offset, section.size)) {
+            continue;
+        }
+
+        QByteArray symbols(reinterpret_cast<const char*>(data + section.offset), static_cast<int>(section.size));
+        bool changed = false;
+        for (quint64 symbol = 0; symbol + symbolSize <= section.size; symbol += symbolSize) {
+            const quint32 index = image.read<quint16>(section.offset + symbol + shndxOffset);
+            quint32 newIndex = 0;
+            if (!remap(index, newIndex)) {
+                return StripNotSupported;
+            }
 
-            if (QFileInfo(*i).isDir()) {
-                info.setQtPath(DeployCore::transportPathToSnapRoot(*i));
+            if (newIndex != index) {
+                writeValue<quint16>(reinterpret_cast<uchar*>(symbols.data()) + symbol + shndxOffset,
+                                    static_cast<quint16>(newIndex), bigEndian);
+                changed = true;
             }
+        }
+
+        if (changed) {
+            patches.push_back({section.offset, symbols});
+        }
+    }
+
+    QByteArray header(reinterpret_cast<const char*>(data), ehsize);
+    uchar *raw = reinterpret_cast<uchar*>(header.data());
+    writeWord(raw + ((is64)? 40: 32), newShoff, is64, bigEndian);
+    writeValue<quint16>(raw + ((is64)? 60: 48), static_cast<quint16>(count), bigEndian);
+    writeValue<quint16>(raw + ((is64)? 62: 50), static_cast<quint16>(newIndexes[shstrndx]), bigEndian);
+    patches.push_back({0, header});
+
+    std::sort(patches.begin(), patches.end(), [](const QPair<quint64, QByteArray> &left,
+                                                 const QPair<quint64, QByteArray> &right) {
+        return left.first < right.first;
+    });
+
+    // the result is written into the temporary file, so the library is not corrupted if the disk is full.
+    QSaveFile result(lib);
+    if (!result.open(QIODevice::WriteOnly)) {
+        return StripFailed;
+    }
+
+    auto writeRaw = [&result, data](quint64 begin, quint64 end) {
+        return begin >= end ||
+                result.write(reinterpret_cast<const char*>(data + begin), static_cast<qint64>(end - begin)) ==
+                static_cast<qint64>(end - begin);
+    };
+
+    quint64 position = 0;
+    for (const auto &patch: qAsConst(patches)) {
+        if (!writeRaw(position, patch.first) || result.write(patch.second) != patch.second.size()) {
+            return StripFailed;
+        }
+
+        position = patch.first + static_cast<quint64>(patch.second.size());
+    }
+
+    if (!writeRaw(position, fixedEnd) || result.write(tail) != tail.size()) {
+        return StripFailed;
+    }
+
+    const auto permissions = file.permissions();
+    file.unmap(const_cast<uchar*>(data));
+    file.close();
 
+    if (!result.commit()) {
+        return StripFailed;
+    }
+
+    QFile::setPermissions(lib, permissions);
+
+    return StripDone;
+}
+
+QString ELF::findRPath(const ElfDynamicInfo &dynamic) const {
+    // The DT_RPATH is ignored by the loader when the DT_RUNPATH exists.
+    const QByteArray &paths = (dynamic.runpath.size())? dynamic.runpath: dynamic.rpath;
+
+    for (const auto &path: paths.split(':')) {
+        if (path.isEmpty() || path.contains("$ORIGIN") || path.contains("${ORIGIN}")) {
+            continue;
+        }
+
+        if (QFileInfo(path).isDir()) {
+            return DeployCore::transportPathToSnapRoot(path);
         }
     }
 
+    return "";
+}
+
+bool ELF::getLibInfo(const QString &lib, LibInfo &info) const {
+    ElfDynamicInfo dynamic;
+
+    if (!readDynamic(lib, dynamic)) {
+        info.setPlatform(UnknownPlatform);
+        return false;
+    }
+
+    info.setPlatform(dynamic.platform);
+
+    if (!QuasarAppUtils::Params::isEndable("noCheckRPATH")) {
+        info.setQtPath(findRPath(dynamic));
+    }
+
     info.setName(QFileInfo(lib).fileName());
     info.setPath(QFileInfo(lib).absolutePath());
 
-    auto dep = reader.dependencies();
-    for (const auto &i : dep) {
+    for (const auto &i : qAsConst(dynamic.needed)) {
         info.addDependncies(i);
     }
 
@@ -7,22 +7,111 @@
 
 #ifndef ELF_H
 #define ELF_H
-#include "../qtTools/src/shared/winutils/elfreader.h"
 
 #include "igetlibinfo.h"
 
+#include <QByteArrayList>
+#include <QVector>
+
+/**
+ * @brief The ElfDynamicInfo struct contains the dynamic section of the elf file.
+ */
+struct ElfDynamicInfo {
+    Platform platform = UnknownPlatform;
+    QByteArrayList needed;
+    QByteArray soname;
+    QByteArray rpath;
+    QByteArray runpath;
+};
+
+/**
+ * @brief The ElfSection struct contains the header of the one section of the elf file.
+ */
+struct ElfSection {
+    QByteArray name;
+    quint32 type = 0;
+    quint64 flags = 0;
+    quint64 offset = 0;
+    quint64 size = 0;
+};
+
 class ELF : public IGetLibInfo
 {
 
 private:
-    QByteArrayList getDynamicString(ElfReader &reader) const;
-
-    int getVersionOfTag(const QByteArray &tag, QByteArray &source) const;
+    QString findRPath(const ElfDynamicInfo &dynamic) const;
 
 public:
+    enum StripResult {
+        StripDone,
+        /// the file is not elf file or has layout that can not be changed without moving of the loaded data.
+        StripNotSupported,
+        StripFailed
+    };
+
     ELF();
 
+    /**
+     * @brief readDynamic This method reads the elf header and the dynamic section of the file in one pass.
+     * The file is mapped into memory, so the string table is not copied.
+     * @param lib This is path to elf file.
+     * @param dynamic This is result of parsing.
+     * @return true if the file is valid elf file.
+     */
+    bool readDynamic(const QString &lib, ElfDynamicInfo &dynamic) const;
+
+    /**
+     * @brief getPlatform This method reads only the elf header of the file.
+     * @param lib This is path to elf file.
+     * @return platform of the file or UnknownPlatform if the file is not valid elf file.
+     */
+    Platform getPlatform(const QString &lib) const;
+
+    /**
+     * @brief isElf This method checks the magic and the header of the file.
+     * @param lib This is path to file.
+     * @return true if the file is elf file of any platform.
+     */
+    bool isElf(const QString &lib) const;
+
+    /**
+     * @brief readSections This method reads the section headers of the file.
+     * @param lib This is path to elf file.
+     * @param sections This is list of sections in order of the section header table.
+     * @return true if the file is valid elf file.
+     */
+    bool readSections(const QString &lib, QVector<ElfSection> &sections) const;
+
+    /**
+     * @brief isStrippable This method checks that the file contains the symbol table or the debug sections.
+     * @param lib This is path to elf file.
+     * @return true if the strip will remove something from the file.
+     */
+    bool isStrippable(const QString &lib) const;
+
+    /**
+     * @brief strip This method removes the .symtab, the .strtab and the .debug* sections from the file (same as strip --strip-unneeded).
+     *  The loaded data is not moved, only the not loaded sections placed after it and the section header table are rewritten.
+     *  The result is written into the temporary file and replaces the library only after the whole file is written,
+     *  so the library is not corrupted if the writing fails. The permissions of the library are kept.
+     * @param lib This is path to elf file.
+     * @return result of stripping. The file is not changed if result is StripNotSupported.
+     */
+    StripResult strip(const QString &lib) const;
+
+    /**
+     * @brief splitDebug This method moves the debug information of the file into the separate debug file (same as objcopy --only-keep-debug)
+     *  and strips the file. The stripped file contains the .gnu_debuglink section with the name and the crc32 of the debug file.
+     * @param lib This is path to elf file.
+     * @param debugFile This is path to new debug file.
+     * @return result of stripping. The file is not changed if result is StripNotSupported.
+     */
+    StripResult splitDebug(const QString &lib, const QString &debugFile) const;
+
     bool getLibInfo(const QString &lib, LibInfo &info) const override;
+
+private:
+    StripResult stripPrivate(const QString &lib, const QByteArray &debugLink, quint32 crc) const;
 };
 
 #endif // ELF_H
@@ -92,14 +92,21 @@ void Envirement::clear() {
 }
 
 bool Envirement::inThisEnvirement(const QString &file) const {
+    return containsEnvPath(envPath(file));
+}
+
+QString Envirement::envPath(const QString &file) {
     QFileInfo info (file);
 
     if (info.isFile()) {
-        return _dataEnvironment.contains(PathUtils::fixPath(info.absolutePath()));
+        return PathUtils::fixPath(info.absolutePath());
     }
 
-    return _dataEnvironment.contains(PathUtils::fixPath(info.absoluteFilePath()));
+    return PathUtils::fixPath(info.absoluteFilePath());
+}
 
+bool Envirement::containsEnvPath(const QString &envPath) const {
+    return _dataEnvironment.contains(envPath);
 }
 
 int Envirement::size() const {
@@ -39,6 +39,20 @@ public:
     // return true if file exits in this envirement
     bool inThisEnvirement(const QString &file) const;
 
+    /**
+     * @brief envPath This method returns the normalized directory that used by the inThisEnvirement method for checking of the file.
+     * @param file This is path to file or directory.
+     * @return normalized path of directory.
+     */
+    static QString envPath(const QString &file);
+
+    /**
+     * @brief containsEnvPath This method checks the normalized directory returned by the envPath method. This method does not access to file system.
+     * @param envPath This is result of the envPath method.
+     * @return true if the directory exits in this envirement.
+     */
+    bool containsEnvPath(const QString &envPath) const;
+
     int size() const;
     QString concatEnv() const;
 
@@ -98,6 +98,14 @@ QList<QString> Extracter::angleGLLibs() {
 
 void Extracter::extractAllTargets() {
     auto cfg = DeployCore::_config;
+
+    QStringList targets;
+    for (auto i = cfg->packages().cbegin(); i != cfg->packages().cend(); ++i) {
+        targets += i.value().targets().values();
+    }
+
+    _scaner->preScan(targets);
+
     for (auto i = cfg->packages().cbegin(); i != cfg->packages().cend(); ++i) {
         auto &dep = _packageDependencyes[i.key()];
 
@@ -167,6 +175,8 @@ void Extracter::copyExtraPlugins(const QString& package) {
                                             QuasarAppUtils::Warning);
             }
 
+            _scaner->preScan(plugins);
+
             for (const auto& plugin : qAsConst(plugins)) {
                 extractPluginLib(plugin, package);
             }
@@ -191,6 +201,8 @@ void Extracter::extractPlugins() {
         _fileManager->copyFiles(plugins, targetPath + distro.getPluginsOutDir(), 1,
                                 DeployCore::debugExtensions(), &listItems);
 
+        _scaner->preScan(listItems);
+
         for (const auto &item : qAsConst(listItems)) {
             extractPluginLib(item, i.key());
         }
@@ -205,10 +217,8 @@ void Extracter::copyLibs(const QSet<QString> &files, const QString& package) {
     auto targetPath = cnf->getTargetDir() + "/" + package;
     auto distro = cnf->getDistroFromPackage(package);
 
-    for (const auto &file : files) {
-        if (!_fileManager->smartCopyFile(file, targetPath + distro.getLibOutDir())) {
-            QuasarAppUtils::Params::log(file + " not copied");
-        }
+    if (!_fileManager->copyFileList(files.values(), targetPath + distro.getLibOutDir(), nullptr, true)) {
+        QuasarAppUtils::Params::log("some libraries of the " + package + " package not copied");
     }
 }
 
@@ -236,12 +246,18 @@ void Extracter::copyFiles() {
             copyLibs(_packageDependencyes[i.key()].systemLibs(), i.key());
         }
 
+        copyExtraData(_packageDependencyes[i.key()].extraData(), i.key());
+    }
 
-        if (!QuasarAppUtils::Params::isEndable("noStrip") && !_fileManager->strip(cnf->getTargetDir())) {
-            QuasarAppUtils::Params::log("strip failed!");
+    if (!QuasarAppUtils::Params::isEndable("noStrip")) {
+        QString debugDir;
+        if (cnf->debugPackage.size()) {
+            debugDir = cnf->getTargetDir() + "/" + cnf->debugPackage;
         }
 
-        copyExtraData(_packageDependencyes[i.key()].extraData(), i.key());
+        if (!_fileManager->stripDeployedFiles(cnf->getTargetDir(), debugDir)) {
+            QuasarAppUtils::Params::log("strip failed!");
+        }
     }
 }
 
@@ -320,10 +336,13 @@ bool Extracter::copyTranslations(const QStringList &list, const QString& package
     auto targetPath = cnf->getTargetDir() + "/" + package;
     auto distro = cnf->getDistroFromPackage(package);
 
+    QStringList translations;
     for (const auto &i: listItems) {
-        _fileManager->copyFile(i.absoluteFilePath(), targetPath + distro.getTrOutDir());
+        translations.push_back(i.absoluteFilePath());
     }
 
+    _fileManager->copyFileList(translations, targetPath + distro.getTrOutDir());
+
     if (isWebEngine(package)) {
         auto trOut = targetPath + distro.getTrOutDir();
         auto tr = cnf->qtDir.getTranslations() + "/qtwebengine_locales";
@@ -437,6 +456,8 @@ bool Extracter::extractQml() {
                 return false;
             }
 
+            _scaner->preScan(listItems);
+
             for (const auto &item : qAsConst(listItems)) {
                 extractPluginLib(item, i.key());
             }
@@ -15,11 +15,102 @@
 #include <QProcess>
 #include <fstream>
 #include "pathutils.h"
+#include "parallel.h"
+#include "elf_type.h"
+
+#include <QAtomicInteger>
+#include <QMutexLocker>
+#include <algorithm>
 
 #ifdef Q_OS_WIN
 #include "windows.h"
 #endif
 
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @brief isFiltered This function checks the file with the filter and the ignore rules of the config.
+ * @param info This is file.
+ * @param filter This is list of forbiden names.
+ * @param ruleLogLvl This is verbose level of message about the file ignored by rule.
+ * @return true if file should be skipped.
+ */
+bool isFiltered(const QFileInfo &info, const QStringList &filter,
+                QuasarAppUtils::VerboseLvl ruleLogLvl) {
+
+    for (const auto &i: filter) {
+        if (info.fileName().contains(i, ONLY_WIN_CASE_INSENSIATIVE)) {
+            QuasarAppUtils::Params::log(
+                        info.absoluteFilePath() + " ignored by filter " + i,
+                        QuasarAppUtils::VerboseLvl::Debug);
+            return true;
+        }
+    }
+
+    auto config = DeployCore::_config;
+
+    LibInfo libInfo;
+    libInfo.setName(info.fileName());
+    libInfo.setPath(info.absolutePath());
+    libInfo.setPlatform(GeneralFile);
+
+    if (config)
+        if (auto rule = config->ignoreList.isIgnore(libInfo)) {
+            QuasarAppUtils::Params::log(
+                        info.absoluteFilePath() + " ignored by rule " + rule->label,
+                        ruleLogLvl);
+            return true;
+        }
+
+    return false;
+}
+
+enum class IncrementalMode {
+    Off,
+    /// compare the sizes and the modification times.
+    Fast,
+    /// compare the content hashes.
+    Strict
+};
+
+IncrementalMode incrementalMode() {
+    if (!QuasarAppUtils::Params::isEndable("incremental")) {
+        return IncrementalMode::Off;
+    }
+
+    if (QuasarAppUtils::Params::getStrArg("incremental").compare("strict", Qt::CaseInsensitive) == 0) {
+        return IncrementalMode::Strict;
+    }
+
+    return IncrementalMode::Fast;
+}
+
+/**
+ * @brief hardLink This function creates the hard link of the file. The symbolic links are linked as is (not followed).
+ * @param from This is existing file.
+ * @param to This is new link.
+ * @return true if link created.
+ */
+bool hardLink(const QString &from, const QString &to) {
+#ifdef Q_OS_UNIX
+    return ::link(QFile::encodeName(from).constData(), QFile::encodeName(to).constData()) == 0;
+#elif defined(Q_OS_WIN)
+    return CreateHardLinkW(reinterpret_cast<LPCWSTR>(QDir::toNativeSeparators(to).utf16()),
+                           reinterpret_cast<LPCWSTR>(QDir::toNativeSeparators(from).utf16()),
+                           nullptr);
+#else
+    Q_UNUSED(from)
+    Q_UNUSED(to)
+    return false;
+#endif
+}
+
+}
+
 FileManager::FileManager() {
 }
 
@@ -37,33 +128,107 @@ bool FileManager::initDir(const QString &path) {
 
 
 QSet<QString> FileManager::getDeployedFiles() const {
+    QMutexLocker locker(&_deployedFilesMutex);
     return _deployedFiles;
 }
 
 QStringList FileManager::getDeployedFilesStringList() const {
+    QMutexLocker locker(&_deployedFilesMutex);
     return _deployedFiles.values();
 }
 
 void FileManager::loadDeployemendFiles(const QString &targetDir) {
-    auto settings = QuasarAppUtils::Settings::get();
-
     if (targetDir.isEmpty())
         return;
 
-    QStringList deployedFiles = settings->getValue(targetDir, "").toStringList();
+    DeployManifest manifest;
+    QStringList deployedFiles;
+    bool fromSettings = false;
 
+    if (manifest.load(DeployManifest::path(targetDir), targetDir)) {
+        deployedFiles = manifest.files();
+    } else {
+        // the old versions save the list of the deployed files into the settings,
+        // the list is read only once and removed after saving of the manifest.
+        auto settings = QuasarAppUtils::Settings::get();
+        deployedFiles = settings->getValue(targetDir, "").toStringList();
+        fromSettings = deployedFiles.size();
+    }
+
+    QMutexLocker locker(&_deployedFilesMutex);
+    _fromSettings = fromSettings;
 #if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
-    _deployedFiles.unite(deployedFiles.toSet());
+    _previousFiles = deployedFiles.toSet();
 #else
-    _deployedFiles.unite(QSet<QString>(deployedFiles.begin(), deployedFiles.end()));
+    _previousFiles = QSet<QString>(deployedFiles.begin(), deployedFiles.end());
 #endif
+    _deployedFiles.unite(_previousFiles);
+    _manifest = manifest;
+}
+
+void FileManager::markTargeted(const QString &path) {
+    if (incrementalMode() == IncrementalMode::Off) {
+        return;
+    }
+
+    QMutexLocker locker(&_deployedFilesMutex);
+    _targeted += QFileInfo(path).absoluteFilePath();
+}
+
+int FileManager::removeStaleFiles() {
+    if (incrementalMode() == IncrementalMode::Off) {
+        return 0;
+    }
+
+    QSet<QString> stale;
+    {
+        QMutexLocker locker(&_deployedFilesMutex);
+        stale = _previousFiles - _targeted;
+    }
+
+    const QStringList paths = stale.values();
+    const auto result = clearFiles(paths, manifest());
+
+    {
+        QMutexLocker locker(&_deployedFilesMutex);
+        for (const auto &path : paths) {
+            if (!QFileInfo::exists(path)) {
+                _deployedFiles -= path;
+                _manifest.remove(path);
+            }
+        }
+    }
+
+    QuasarAppUtils::Params::log(QString("Removed %0 stale files (%1 bytes) and %2 directories of the previous deploy").
+                                arg(result.files).
+                                arg(result.bytes).
+                                arg(result.dirs),
+                                QuasarAppUtils::Info);
+
+    return result.files;
+}
+
+DeployManifest FileManager::manifest() const {
+    QMutexLocker locker(&_deployedFilesMutex);
+    return _manifest;
 }
 
 
 bool FileManager::addToDeployed(const QString& path) {
     auto info = QFileInfo(path);
     if (info.exists()) {
-        _deployedFiles += info.absoluteFilePath();
+        {
+            QMutexLocker locker(&_deployedFilesMutex);
+            _deployedFiles += info.absoluteFilePath();
+
+            // the information of file is already read by the exists method, so the record does not need the new stat.
+            if (!_manifest.contains(info.absoluteFilePath())) {
+                _manifest.insert(info.absoluteFilePath(), DeployManifest::createEntry(info));
+            }
+        }
+
+        markTargeted(info.absoluteFilePath());
+
         if (!QFile::setPermissions(path, static_cast<QFile::Permission>(0x7775))) {
             QuasarAppUtils::Params::log("permishens set fail", QuasarAppUtils::Warning);
         }
@@ -85,13 +250,51 @@ bool FileManager::addToDeployed(const QString& path) {
 }
 
 void FileManager::removeFromDeployed(const QString &path) {
-
+    QMutexLocker locker(&_deployedFilesMutex);
     _deployedFiles -= path;
 }
 
 void FileManager::saveDeploymendFiles(const QString& targetDir) {
+    if (targetDir.isEmpty())
+        return;
+
+    DeployManifest manifest;
+    {
+        QMutexLocker locker(&_deployedFilesMutex);
+        // the records are created by the addToDeployed method, the files of the old versions are saved without records.
+        for (const auto &file : qAsConst(_deployedFiles)) {
+            manifest.insert(file, _manifest.value(file));
+        }
+    }
+
+    const QString manifestFile = DeployManifest::path(targetDir);
+    if (!manifest.size()) {
+        QFile::remove(manifestFile);
+        removeSettingsList(targetDir);
+        return;
+    }
+
+    if (!QFileInfo(targetDir).isDir() || !manifest.save(manifestFile, targetDir)) {
+        QuasarAppUtils::Params::log("Failed to save the deploy manifest " + manifestFile,
+                                    QuasarAppUtils::Warning);
+        return;
+    }
+
+    removeSettingsList(targetDir);
+}
+
+void FileManager::removeSettingsList(const QString &targetDir) {
+    {
+        QMutexLocker locker(&_deployedFilesMutex);
+        if (!_fromSettings) {
+            return;
+        }
+
+        _fromSettings = false;
+    }
+
     auto settings = QuasarAppUtils::Settings::get();
-    settings->setValue(targetDir, getDeployedFilesStringList());
+    settings->setValue(targetDir, QVariant());
 }
 
 bool FileManager::strip(const QString &dir) const {
@@ -119,29 +322,173 @@ bool FileManager::strip(const QString &dir) const {
         return res;
     } else {
 
-        auto sufix = info.completeSuffix();
-        if (!sufix.contains("so") && !sufix.contains("dll")) {
+        if (!isStripCandidate(info)) {
             return true;
         }
 
-        QProcess P;
-        P.setProgram("strip");
-        P.setArguments(QStringList() << info.absoluteFilePath());
-        P.start();
+        return stripFile(info.absoluteFilePath());
+    }
+#endif
+}
 
-        if (!P.waitForStarted())
-            return false;
-        if (!P.waitForFinished())
-            return false;
+bool FileManager::stripDeployedFiles(const QString &targetDir, const QString &debugDir) {
+    QStringList files;
+    QStringList unchanged;
+    {
+        QMutexLocker locker(&_deployedFilesMutex);
+        files.swap(_stripQueue);
+        unchanged.swap(_unchangedQueue);
+    }
+
+#ifdef Q_OS_WIN
+    Q_UNUSED(targetDir)
+    Q_UNUSED(debugDir)
+    return true;
+#else
+    files.removeDuplicates();
+    const QDir root(targetDir);
 
-        return P.exitCode() == 0;
+    auto debugFileOf = [&root, &debugDir](const QString &file) {
+        QString relative = root.relativeFilePath(file);
+        if (relative.startsWith("..")) {
+            relative = QFileInfo(file).fileName();
+        }
+
+        return debugDir + "/" + relative + ".debug";
+    };
+
+    // the unchanged files are stripped by the previous deploy, so the debug files of them stay actual.
+    if (debugDir.size()) {
+        for (const auto &file: qAsConst(unchanged)) {
+            const QString debugFile = debugFileOf(file);
+            if (QFileInfo(debugFile).isFile()) {
+                addToDeployed(debugFile);
+            }
+        }
     }
+
+    QAtomicInt stripped;
+    QAtomicInt failed;
+    ELF elf;
+
+    Parallel::forEach(files.size(), [&](int index) {
+        const QString &file = files[index];
+        QFileInfo info(file);
+
+        if (!info.isFile() || !isStripCandidate(info)) {
+            return;
+        }
+
+        // the elf files without the symbols are skipped without starting of the strip process.
+        // The other libraries (for example the dll of the windows distribution) are stripped by the strip tool.
+        const bool isElf = elf.isElf(file);
+        if (isElf && !elf.isStrippable(file)) {
+            return;
+        }
+
+        if (isElf && debugDir.size()) {
+            const QString debugFile = debugFileOf(file);
+            switch (elf.splitDebug(file, debugFile)) {
+            case ELF::StripDone:
+                addToDeployed(debugFile);
+                break;
+            case ELF::StripFailed:
+                QuasarAppUtils::Params::log("split of the debug information failed: " + file,
+                                            QuasarAppUtils::Warning);
+                failed.fetchAndAddRelaxed(1);
+                return;
+            case ELF::StripNotSupported:
+                QuasarAppUtils::Params::log("The debug information of the " + file + " can not be saved, it will be removed",
+                                            QuasarAppUtils::Warning);
+                break;
+            }
+        }
+
+        if (!stripFile(file)) {
+            QuasarAppUtils::Params::log("strip failed: " + file,
+                                        QuasarAppUtils::Warning);
+            failed.fetchAndAddRelaxed(1);
+            return;
+        }
+
+        stripped.fetchAndAddRelaxed(1);
+        info.refresh();
+
+        QMutexLocker locker(&_deployedFilesMutex);
+        if (_manifest.contains(file)) {
+            auto entry = _manifest.value(file);
+            entry.size = info.size();
+            entry.mtime = info.lastModified().toMSecsSinceEpoch();
+            _manifest.insert(file, entry);
+        }
+    });
+
+    QuasarAppUtils::Params::log(QString("Stripped %0 of %1 deployed files").
+                                arg(stripped.loadAcquire()).
+                                arg(files.size()),
+                                QuasarAppUtils::Info);
+
+    return !failed.loadAcquire();
 #endif
 }
 
+bool FileManager::isStripCandidate(const QFileInfo &info) const {
+    auto sufix = info.completeSuffix();
+    return sufix.contains("so") || sufix.contains("dll");
+}
+
+bool FileManager::stripFile(const QString &file) const {
+    switch (ELF().strip(file)) {
+    case ELF::StripDone:
+        return true;
+    case ELF::StripFailed:
+        return false;
+    case ELF::StripNotSupported:
+        break;
+    }
+
+    QProcess P;
+    P.setProgram("strip");
+    P.setArguments(QStringList() << file);
+    P.start();
+
+    if (!P.waitForStarted())
+        return false;
+    if (!P.waitForFinished())
+        return false;
+
+    return P.exitCode() == 0;
+}
 
 bool FileManager::fileActionPrivate(const QString &file, const QString &target,
-                                    QStringList *masks, bool isMove, bool targetIsFile) {
+                                    QStringList *masks, bool isMove, bool targetIsFile,
+                                    bool initTarget) {
+
+    QString tergetFile;
+    switch (prepareAction(file, target, masks, isMove, targetIsFile, initTarget, tergetFile)) {
+    case ActionState::Skipped:
+        return true;
+    case ActionState::Failed:
+        return false;
+    case ActionState::Ready:
+        break;
+    }
+
+    QFile sourceFile(file);
+    QString error;
+    bool done = (isMove)? sourceFile.rename(tergetFile):
+                          _copyBackend.copy(file, tergetFile, &error);
+
+    if (isMove) {
+        error = sourceFile.errorString();
+    }
+
+    return finishAction(file, tergetFile, isMove, done, error);
+}
+
+FileManager::ActionState FileManager::prepareAction(const QString &file, const QString &target,
+                                                    QStringList *masks, bool isMove, bool targetIsFile,
+                                                    bool initTarget, QString &tergetFile) {
     
     auto info = QFileInfo(file);
     
@@ -157,29 +504,54 @@ bool FileManager::fileActionPrivate(const QString &file, const QString &target,
 
     if (!copy) {
         QuasarAppUtils::Params::log(((isMove)? "skip move :": "skip copy (by mask):" + file ));
-        return true;
+        return ActionState::Skipped;
     }
 
     auto name = info.fileName();
-    QString tergetFile = target + QDir::separator() + name;
+    tergetFile = target + QDir::separator() + name;
     if (targetIsFile) {
         tergetFile = target;
     }
 
     info.setFile(tergetFile);
+    markTargeted(tergetFile);
 
-    if (!initDir(info.absolutePath())) {
-        return false;
+    if (initTarget && !initDir(info.absolutePath())) {
+        return ActionState::Failed;
     }
 
     if (QFileInfo(file).absoluteFilePath() ==
             QFileInfo(tergetFile).absoluteFilePath()) {
-        return true;
+        return ActionState::Skipped;
+    }
+
+    auto incremental = incrementalMode();
+    if (!isMove && incremental != IncrementalMode::Off) {
+        DeployManifest::Entry entry;
+        bool found = false;
+        {
+            QMutexLocker locker(&_deployedFilesMutex);
+            found = _manifest.contains(info.absoluteFilePath());
+            if (found) {
+                entry = _manifest.value(info.absoluteFilePath());
+            }
+        }
+
+        if (found && DeployManifest::isUnchanged(entry, file, tergetFile,
+                                                 incremental == IncrementalMode::Strict)) {
+            QuasarAppUtils::Params::log("skip unchanged :" + file,
+                                        QuasarAppUtils::Debug);
+
+            QMutexLocker locker(&_deployedFilesMutex);
+            _deployedFiles += info.absoluteFilePath();
+            _unchangedQueue.push_back(info.absoluteFilePath());
+            return ActionState::Skipped;
+        }
     }
 
     if (!QuasarAppUtils::Params::isEndable("noOverwrite") &&
             info.exists() && !removeFile( tergetFile)) {
-        return false;
+        return ActionState::Failed;
     }
 
     if (isMove) {
@@ -190,34 +562,55 @@ bool FileManager::fileActionPrivate(const QString &file, const QString &target,
                                     QuasarAppUtils::Info);
     }
 
-
-    QFile sourceFile(file);
-    auto sourceFileAbsalutePath = QFileInfo(file).absoluteFilePath();
-
     bool tarExits = QFileInfo(tergetFile).exists();
     if (tarExits && !QuasarAppUtils::Params::isEndable("noOverwrite")) {
         QuasarAppUtils::Params::log(tergetFile + " already exists!",
                                     QuasarAppUtils::Info);
-        return true;
+        return ActionState::Skipped;
     }
 
-    if (!((isMove)?
-          sourceFile.rename(tergetFile):
-          sourceFile.copy(tergetFile))) {
+    return ActionState::Ready;
+}
+
+bool FileManager::finishAction(const QString &file, const QString &tergetFile,
+                               bool isMove, bool done, const QString &error) {
+
+    if (!done) {
 
         QuasarAppUtils::Params::log("Operation fail " + file + " >> " + tergetFile,
                                     QuasarAppUtils::Error);
 
-        QuasarAppUtils::Params::log(sourceFile.errorString(),
+        QuasarAppUtils::Params::log(error,
                                     QuasarAppUtils::Error);
         return false;
     }
 
     if (isMove) {
-        removeFromDeployed(sourceFileAbsalutePath);
+        removeFromDeployed(QFileInfo(file).absoluteFilePath());
+    }
+
+    auto incremental = incrementalMode();
+    const QString target = QFileInfo(tergetFile).absoluteFilePath();
+
+    {
+        QMutexLocker locker(&_deployedFilesMutex);
+        _stripQueue.push_back(target);
+
+        // the record of the previous deploy is replaced by the record without origin.
+        if (isMove || incremental == IncrementalMode::Off) {
+            _manifest.remove(target);
+        }
     }
 
     addToDeployed(tergetFile);
+
+    if (incremental != IncrementalMode::Off && !isMove) {
+        auto entry = DeployManifest::createEntry(file, tergetFile, incremental == IncrementalMode::Strict);
+
+        QMutexLocker locker(&_deployedFilesMutex);
+        _manifest.insert(target, entry);
+    }
+
     return true;
 }
 
@@ -229,20 +622,39 @@ bool FileManager::smartCopyFile(const QString &file,
                                 const QString &target,
                                 QStringList *mask,
                                 bool ifFileTarget) {
+    return smartCopyPrivate(file, target, mask, ifFileTarget, true);
+}
+
+bool FileManager::copyFileList(const QStringList &files, const QString &target,
+                               QStringList *mask, bool smart) {
+    QVector<CopyTask> tasks;
+    tasks.reserve(files.size());
+    for (const auto &file: files) {
+        tasks.push_back({file, target, smart});
+    }
+
+    return copyTasks(tasks, nullptr, mask);
+}
+
+bool FileManager::smartCopyPrivate(const QString &file,
+                                   const QString &target,
+                                   QStringList *mask,
+                                   bool ifFileTarget,
+                                   bool initTarget) {
     auto config = DeployCore::_config;
 
     if (file.contains(config->getTargetDir(), ONLY_WIN_CASE_INSENSIATIVE)) {
-        if (!moveFile(file, target, mask)) {
+        if (!fileActionPrivate(file, target, mask, true, false, initTarget)) {
             QuasarAppUtils::Params::log(" file not moved! try copy");
 
-            if (!copyFile(file, target, mask, ifFileTarget)) {
+            if (!fileActionPrivate(file, target, mask, false, ifFileTarget, initTarget)) {
                 QuasarAppUtils::Params::log("not copy target to bin dir " + file,
                                             QuasarAppUtils::Error);
                 return false;
             }
         }
     } else {
-        if (!copyFile(file, target, mask, ifFileTarget)) {
+        if (!fileActionPrivate(file, target, mask, false, ifFileTarget, initTarget)) {
             QuasarAppUtils::Params::log("not copy target to bin dir " + file,
                                         QuasarAppUtils::Error);
             return false;
@@ -261,64 +673,152 @@ bool FileManager::copyFolder(const QString &from,
                              const QStringList &filter,
                              QStringList *listOfCopiedItems, QStringList *mask, bool force) {
 
+    QVector<CopyTask> tasks;
+    collectFolder(from, to, filter, force, tasks);
+    copyTasks(tasks, listOfCopiedItems, mask);
+
+    return true;
+}
+
+void FileManager::collectFolder(const QString &from,
+                                const QString &to,
+                                const QStringList &filter,
+                                bool force,
+                                QVector<CopyTask> &tasks) const {
+
     QDir fromDir(from);
 
     auto list = fromDir.entryInfoList(QDir::NoDotAndDotDot | QDir::AllEntries);
 
     for (const auto &item : list) {
         if (item.isDir()) {
+            collectFolder(item.absoluteFilePath(), to + "/" + item.fileName(), filter, force, tasks);
+            continue;
+        }
 
-            if (!copyFolder(item.absoluteFilePath(), to + "/" + item.fileName(), filter, listOfCopiedItems, mask, force)) {
-                return false;
-            }
+        if (!force && isFiltered(item, filter, QuasarAppUtils::VerboseLvl::Debug)) {
+            continue;
+        }
 
+        tasks.push_back({item.absoluteFilePath(), to, false});
+    }
+}
+
+bool FileManager::copyTasks(const QVector<CopyTask> &tasks,
+                            QStringList *listOfCopiedItems,
+                            QStringList *mask) {
+
+    const bool keepFirst = QuasarAppUtils::Params::isEndable("noOverwrite");
+
+    QVector<QString> targets;
+    targets.reserve(tasks.size());
+
+    QHash<QString, int> owners;
+    QStringList dirs;
+    for (int i = 0; i < tasks.size(); ++i) {
+        const auto &task = tasks[i];
+        targets.push_back(task.target + "/" + QFileInfo(task.file).fileName());
+
+        auto owner = owners.find(targets[i]);
+        if (owner == owners.end()) {
+            owners.insert(targets[i], i);
+            dirs.push_back(task.target);
+        } else if (!keepFirst) {
+            owner.value() = i;
+        }
+    }
+
+    dirs.removeDuplicates();
+
+    QSet<QString> invalidDirs;
+    for (const auto &dir: qAsConst(dirs)) {
+        if (!initDir(dir)) {
+            invalidDirs.insert(dir);
+        }
+    }
+
+    QVector<bool> resultsData(tasks.size(), false);
+    bool *results = resultsData.data();
+
+    // in the batch mode the targets are prepared by the workers and files are copied by the one io_uring batch.
+    const bool batch = _copyBackend.isBatchEnabled();
+    QVector<QString> targetFilesData(batch? tasks.size(): 0);
+    QString *targetFiles = targetFilesData.data();
+    QVector<bool> readyData(tasks.size(), false);
+    bool *ready = readyData.data();
+
+    Parallel::forEach(tasks.size(), [&](int i) {
+        const auto &task = tasks[i];
+
+        if (owners.value(targets.at(i)) != i) {
+            // the target file will be written by another task.
+            results[i] = !keepFirst;
+            return;
+        }
+
+        if (invalidDirs.contains(task.target)) {
+            results[i] = false;
+        } else if (task.smart) {
+            results[i] = smartCopyPrivate(task.file, task.target, mask, false, false);
+        } else if (!batch || task.move) {
+            results[i] = fileActionPrivate(task.file, task.target, mask, task.move, false, false);
         } else {
+            auto state = prepareAction(task.file, task.target, mask, false, false, false, targetFiles[i]);
+            ready[i] = state == ActionState::Ready;
+            results[i] = state == ActionState::Skipped;
+            if (ready[i]) {
+                return;
+            }
+        }
 
-            if (!force) {
-                QString skipFilter = "";
-                for (const auto &i: filter) {
-                    if (item.fileName().contains(i, ONLY_WIN_CASE_INSENSIATIVE)) {
-                        skipFilter = i;
-                        break;
-                    }
-                }
-
-                if (!skipFilter.isEmpty()) {
-                    QuasarAppUtils::Params::log(
-                                item.absoluteFilePath() + " ignored by filter " + skipFilter,
-                                QuasarAppUtils::VerboseLvl::Debug);
-                    continue;
-                }
-                auto config = DeployCore::_config;
-
-                LibInfo info;
-                info.setName(item.fileName());
-                info.setPath(item.absolutePath());
-                info.setPlatform(GeneralFile);
-
-                if (config)
-                    if (auto rule = config->ignoreList.isIgnore(info)) {
-                        QuasarAppUtils::Params::log(
-                                    item.absoluteFilePath() + " ignored by rule " + rule->label,
-                                    QuasarAppUtils::VerboseLvl::Debug);
-                        continue;
-                    }
+        if (!results[i]) {
+            QuasarAppUtils::Params::log(
+                        "not copied file " + targets.at(i),
+                        QuasarAppUtils::VerboseLvl::Warning);
+        }
+    }, Parallel::ioJobs());
+
+    if (batch) {
+        QVector<int> indexes;
+        QVector<UringCopier::Task> copyTasks;
+        for (int i = 0; i < tasks.size(); ++i) {
+            if (ready[i]) {
+                UringCopier::Task task;
+                task.from = tasks[i].file;
+                task.to = targetFiles[i];
+                copyTasks.push_back(task);
+                indexes.push_back(i);
             }
+        }
+
+        _copyBackend.copy(copyTasks);
 
-            if (!copyFile(item.absoluteFilePath(), to , mask)) {
+        Parallel::forEach(copyTasks.size(), [&](int i) {
+            const auto &task = copyTasks.at(i);
+            const int index = indexes.at(i);
+            results[index] = finishAction(task.from, task.to, false,
+                                          task.status == UringCopier::Done, task.error);
+            if (!results[index]) {
                 QuasarAppUtils::Params::log(
-                            "not copied file " + to + "/" + item.fileName(),
+                            "not copied file " + targets.at(index),
                             QuasarAppUtils::VerboseLvl::Warning);
-                continue;
             }
+        }, Parallel::ioJobs());
+    }
 
-            if (listOfCopiedItems) {
-                *listOfCopiedItems << to + "/" + item.fileName();
-            }
+    bool result = true;
+    for (int i = 0; i < tasks.size(); ++i) {
+        if (!results[i]) {
+            result = false;
+            continue;
+        }
+
+        if (listOfCopiedItems) {
+            *listOfCopiedItems << targets[i];
         }
     }
 
-    return true;
+    return result;
 }
 
 bool FileManager::cp(const QString &from,
@@ -359,12 +859,12 @@ bool FileManager::moveFolder(const QString &from, const QString &to, const QStri
     if (!info.exists())
         return false;
 
-    if (!initDir(to)) {
-        return false;
-    }
-
     if (info.isFile()) {
 
+        if (!initDir(to)) {
+            return false;
+        }
+
         if (ignore.size() && info.absoluteFilePath().contains(ignore)) {
             return true;
         }
@@ -375,66 +875,313 @@ bool FileManager::moveFolder(const QString &from, const QString &to, const QStri
         return true;
     }
 
+    if (ignore.isEmpty() && renameFolder(info.absoluteFilePath(), to)) {
+        return true;
+    }
+
+    QVector<CopyTask> tasks;
+    if (!collectMoveTasks(info.absoluteFilePath(), to, ignore, tasks)) {
+        return false;
+    }
+
+    if (!copyTasks(tasks, nullptr, nullptr)) {
+        return false;
+    }
+
+    // the source folder is empty now, so the paths of the source directories are replaced too.
+    if (ignore.isEmpty()) {
+        movePaths(info.absoluteFilePath(), QFileInfo(to).absoluteFilePath());
+    }
+
+    return true;
+}
+
+bool FileManager::collectMoveTasks(const QString &from, const QString &to,
+                                   const QString &ignore, QVector<CopyTask> &tasks) {
+    if (!initDir(to)) {
+        return false;
+    }
+
     QDir dir(from);
     auto list = dir.entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
     for (const auto &i :list) {
-        auto targetDir = to;
         if (i.isDir()) {
-            targetDir += "/" + i.fileName();
+            if (!collectMoveTasks(i.absoluteFilePath(), to + "/" + i.fileName(), ignore, tasks)) {
+                return false;
+            }
+
+            continue;
         }
 
-        if (!moveFolder(i.absoluteFilePath(), targetDir, ignore)) {
-            return false;
+        if (ignore.size() && i.absoluteFilePath().contains(ignore)) {
+            continue;
+        }
+
+        CopyTask task;
+        task.file = i.absoluteFilePath();
+        task.target = to;
+        task.move = true;
+        tasks.push_back(task);
+    }
+
+    return true;
+}
+
+bool FileManager::renameFolder(const QString &from, const QString &to) {
+    QFileInfo target(to);
+
+    // the rename can replace only the empty directory.
+    const bool existingTarget = target.exists();
+    if (existingTarget && (!target.isDir() || !QDir(to).isEmpty())) {
+        return false;
+    }
+
+    if (!QDir().mkpath(target.absolutePath())) {
+        return false;
+    }
+
+    if (existingTarget && !QDir().rmdir(to)) {
+        return false;
+    }
+
+    if (!QDir().rename(from, to)) {
+        QuasarAppUtils::Params::log("The rename of " + from + " is failed, the files will be moved one by one",
+                                    QuasarAppUtils::Debug);
+
+        if (existingTarget) {
+            QDir().mkpath(to);
+        }
+
+        return false;
+    }
+
+    movePaths(from, target.absoluteFilePath());
+
+    QuasarAppUtils::Params::log("Moved " + from + " >> " + to,
+                                QuasarAppUtils::Debug);
+
+    return true;
+}
+
+bool FileManager::linkFolder(const QString &from, const QString &to) {
+    QFileInfo info(from);
+    if (!info.isDir() || QFileInfo(to).absoluteFilePath().startsWith(info.absoluteFilePath() + "/")) {
+        return false;
+    }
+
+    QStringList sources;
+    QStringList targets;
+    if (!collectLinkTasks(info.absoluteFilePath(), QFileInfo(to).absoluteFilePath(), sources, targets)) {
+        return false;
+    }
+
+    QAtomicInt linked;
+    QAtomicInt failed;
+    Parallel::forEach(sources.size(), [&](int i) {
+        const QString &source = sources[i];
+        const QString &target = targets[i];
+
+        QFileInfo targetInfo(target);
+        if ((targetInfo.exists() || targetInfo.isSymLink()) && !QFile::remove(target)) {
+            QuasarAppUtils::Params::log("Qt Operation fail (remove file) " + target,
+                                        QuasarAppUtils::Error);
+            failed.fetchAndAddRelaxed(1);
+            return;
+        }
+
+        if (hardLink(source, target)) {
+            linked.fetchAndAddRelaxed(1);
+            return;
+        }
+
+        // the target is located on another file system or the file system does not support the hard links.
+        QString error;
+        if (!_copyBackend.copy(source, target, &error)) {
+            QuasarAppUtils::Params::log("Qt Operation fail (link) " + source + " >> " + target +
+                                        " error: " + error,
+                                        QuasarAppUtils::Error);
+            failed.fetchAndAddRelaxed(1);
         }
+    }, Parallel::ioJobs());
+
+    QuasarAppUtils::Params::log(QString("View of %0 created in %1: %2 files linked, %3 files copied").
+                                arg(from, to).
+                                arg(linked.loadAcquire()).
+                                arg(sources.size() - linked.loadAcquire() - failed.loadAcquire()),
+                                QuasarAppUtils::Debug);
+
+    return failed.loadAcquire() == 0;
+}
+
+bool FileManager::collectLinkTasks(const QString &from, const QString &to,
+                                   QStringList &sources, QStringList &targets) const {
+    if (!QDir().mkpath(to)) {
+        QuasarAppUtils::Params::log("Qt Operation fail (mkpath) " + to,
+                                    QuasarAppUtils::Error);
+        return false;
+    }
+
+    QDir dir(from);
+    auto list = dir.entryInfoList(QDir::Files | QDir::Dirs | QDir::System | QDir::Hidden | QDir::NoDotAndDotDot);
+    for (const auto &i :list) {
+        if (i.isDir() && !i.isSymLink()) {
+            if (!collectLinkTasks(i.absoluteFilePath(), to + "/" + i.fileName(), sources, targets)) {
+                return false;
+            }
+
+            continue;
+        }
+
+        sources.push_back(i.absoluteFilePath());
+        targets.push_back(to + "/" + i.fileName());
     }
 
     return true;
 }
 
-void FileManager::clear(const QString& targetDir, bool force) {
+void FileManager::movePaths(const QString &from, const QString &to) {
+    const QString prefix = from + "/";
+
+    auto replace = [&from, &to, &prefix](const QString &path, QString &result) {
+        if (path == from) {
+            result = to;
+            return true;
+        }
+
+        if (path.startsWith(prefix)) {
+            result = to + path.mid(from.size());
+            return true;
+        }
+
+        return false;
+    };
+
+    QMutexLocker locker(&_deployedFilesMutex);
+
+    QSet<QString> deployedFiles;
+    deployedFiles.reserve(_deployedFiles.size());
+    for (const auto &path: qAsConst(_deployedFiles)) {
+        QString moved;
+        deployedFiles.insert(replace(path, moved)? moved: path);
+    }
+    _deployedFiles.swap(deployedFiles);
+
+    QSet<QString> targeted;
+    targeted.reserve(_targeted.size());
+    for (const auto &path: qAsConst(_targeted)) {
+        QString moved;
+        targeted.insert(replace(path, moved)? moved: path);
+    }
+    _targeted.swap(targeted);
+
+    for (auto *queue: {&_stripQueue, &_unchangedQueue}) {
+        for (auto &path: *queue) {
+            QString moved;
+            if (replace(path, moved)) {
+                path = moved;
+            }
+        }
+    }
+
+    _manifest.movePaths(from, to);
+}
+
+FileManager::ClearStatistic FileManager::clear(const QString& targetDir, bool force) {
     QuasarAppUtils::Params::log( "clear start!",
                                  QuasarAppUtils::Info);
     if (force) {
         QuasarAppUtils::Params::log("clear force! " + targetDir,
                                     QuasarAppUtils::Info);
         if (QDir(targetDir).removeRecursively()) {
-            return;
+            return {};
         }
 
         QuasarAppUtils::Params::log("Remove target Dir fail, try remove old deployemend files",
                                     QuasarAppUtils::Warning);
     }
 
-    QMultiMap<int, QFileInfo> sortedOldData;
-    for (auto& i : _deployedFiles) {
-        sortedOldData.insert(i.size(), QFileInfo(i));
+    QStringList deployedFiles;
+    DeployManifest manifest;
+    {
+        QMutexLocker locker(&_deployedFilesMutex);
+        deployedFiles = _deployedFiles.values();
+        manifest = _manifest;
     }
 
-    for (auto it = sortedOldData.end(); it != sortedOldData.begin(); --it) {
+    ClearStatistic result = clearFiles(deployedFiles, manifest);
+    QFile::remove(DeployManifest::path(targetDir));
+    removeSettingsList(targetDir);
 
-        auto index = it - 1;
+    QuasarAppUtils::Params::log(QString("Removed %0 files (%1 bytes) and %2 directories of the previous deploy").
+                                arg(result.files).
+                                arg(result.bytes).
+                                arg(result.dirs),
+                                QuasarAppUtils::Info);
 
-        if (!index.value().exists()) {
-            continue;
+    QMutexLocker locker(&_deployedFilesMutex);
+    _deployedFiles.clear();
+    _manifest.clear();
+
+    return result;
+}
+
+FileManager::ClearStatistic FileManager::clearFiles(const QStringList &paths,
+                                                    const DeployManifest &manifest) const {
+    QAtomicInt files;
+    QAtomicInteger<qint64> bytes;
+    QVector<char> isDir(paths.size(), false);
+    char *dirFlags = isDir.data();
+
+    // the type of the path is not saved in the manifest, so try to unlink every path
+    // and check only paths that can not be removed as the file.
+    Parallel::forEach(paths.size(), [&](int index) {
+        const QString &path = paths[index];
+        qint64 size = (manifest.contains(path))? manifest.value(path).size: QFileInfo(path).size();
+
+        if (QFile::remove(path)) {
+            QuasarAppUtils::Params::log("Remove " + path + " because it is deployed file",
+                                        QuasarAppUtils::Debug);
+            files.fetchAndAddRelaxed(1);
+            bytes.fetchAndAddRelaxed(size);
+            return;
         }
 
-        if (index.value().isFile()) {
-            if (removeFile(index.value())) {
-                QuasarAppUtils::Params::log("Remove " + index.value().absoluteFilePath() + " because it is deployed file",
-                                            QuasarAppUtils::Info);
-            }
+        QFileInfo info(path);
+        if (info.isDir()) {
+            dirFlags[index] = true;
+        } else if (info.exists() || info.isSymLink()) {
+            QuasarAppUtils::Params::log("Qt Operation fail (remove file) " + path,
+                                        QuasarAppUtils::Error);
+        }
+    }, Parallel::ioJobs());
 
-        } else {
-            QDir qdir(index.value().absoluteFilePath());
-            if (!qdir.entryList(QDir::NoDotAndDotDot | QDir::AllEntries).count()) {
-                qdir.removeRecursively();
-                QuasarAppUtils::Params::log("Remove " + index.value().absoluteFilePath() + " because it is empty",
-                                            QuasarAppUtils::Info);
-            }
+    QStringList dirs;
+    for (int i = 0; i < paths.size(); ++i) {
+        if (isDir[i]) {
+            dirs.push_back(paths[i]);
         }
     }
 
-    _deployedFiles.clear();
+    // the nested directories are removed before the parents, so every directory is checked only once.
+    std::sort(dirs.begin(), dirs.end(), [](const QString &left, const QString &right) {
+        int leftDepth = left.count('/');
+        int rightDepth = right.count('/');
+        return (leftDepth != rightDepth)? leftDepth > rightDepth: left > right;
+    });
+
+    ClearStatistic result;
+    for (const auto &dir : qAsConst(dirs)) {
+        if (QDir().rmdir(dir)) {
+            QuasarAppUtils::Params::log("Remove " + dir + " because it is empty",
+                                        QuasarAppUtils::Debug);
+            ++result.dirs;
+        }
+    }
+
+    result.files = files.loadAcquire();
+    result.bytes = bytes.loadAcquire();
+
+    return result;
 }
 
 bool FileManager::copyFile(const QString &file, const QString &target,
@@ -471,53 +1218,22 @@ bool FileManager::copyFiles(const QStringList &source,
                             QStringList *listOfCopiedItems,
                             QStringList *mask) {
 
+    QVector<CopyTask> tasks;
+    tasks.reserve(source.size());
+
     for (const auto &item : source) {
 
         QFileInfo info(item);
 
-        QString skipFilter = "";
-        for (const auto &i: filter) {
-            if (info.fileName().contains(i, ONLY_WIN_CASE_INSENSIATIVE)) {
-                skipFilter = i;
-                break;
-            }
-        }
-
-        if (!skipFilter.isEmpty()) {
-            QuasarAppUtils::Params::log(
-                        info.absoluteFilePath() + " ignored by filter " + skipFilter,
-                        QuasarAppUtils::VerboseLvl::Debug);
+        if (isFiltered(info, filter, QuasarAppUtils::VerboseLvl::Info)) {
             continue;
         }
-        auto config = DeployCore::_config;
-
-        LibInfo libInfo;
-        libInfo.setName(info.fileName());
-        libInfo.setPath(info.absolutePath());
-        libInfo.setPlatform(GeneralFile);
-
-        if (config)
-            if (auto rule = config->ignoreList.isIgnore(libInfo)) {
-                QuasarAppUtils::Params::log(
-                            info.absoluteFilePath() + " ignored by rule " + rule->label,
-                            QuasarAppUtils::VerboseLvl::Info);
-                continue;
-            }
 
         auto distanation = changeDistanation(info.absolutePath(), to, saveStructSize);
-
-        if (!copyFile(info.absoluteFilePath(), distanation , mask)) {
-            QuasarAppUtils::Params::log(
-                        "not copied file " + distanation + "/" + info.fileName(),
-                        QuasarAppUtils::VerboseLvl::Warning);
-            continue;
-        }
-
-        if (listOfCopiedItems) {
-            *listOfCopiedItems << distanation + "/" + info.fileName();
-        }
+        tasks.push_back({info.absoluteFilePath(), distanation, false});
     }
 
+    copyTasks(tasks, listOfCopiedItems, mask);
 
     return true;
 }
@@ -541,3 +1257,7 @@ bool FileManager::removeFile(const QFileInfo &file) {
 
     return true;
 }
+
+CopyBackend &FileManager::copyBackend() {
+    return _copyBackend;
+}
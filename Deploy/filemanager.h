@@ -8,19 +8,174 @@
 #ifndef COPYPASTEMANAGER_H
 #define COPYPASTEMANAGER_H
 #include <QFileInfo>
+#include <QMutex>
 #include <QSet>
 #include <QStringList>
+#include <QVector>
 #include <deploy_global.h>
+#include "copybackend.h"
+#include "deploymanifest.h"
 
 
 
 class DEPLOYSHARED_EXPORT FileManager
 {
+public:
+    /**
+     * @brief The ClearStatistic struct contains count of the data removed by the clear method.
+     */
+    struct ClearStatistic {
+        int files = 0;
+        int dirs = 0;
+        qint64 bytes = 0;
+    };
+
 private:
+    /**
+     * @brief The CopyTask struct is one file of the copy batch.
+     */
+    struct CopyTask {
+        QString file;
+        /// target directory of the file.
+        QString target;
+        /// if this option is true then the file will be moved when it located in the target directory (see smartCopyFile).
+        bool smart = false;
+        /// if this option is true then the file will be moved instead of copying.
+        bool move = false;
+    };
+
+    enum class ActionState {
+        /// the file should not be processed (result is true).
+        Skipped,
+        Failed,
+        /// the target is ready for the copying or moving.
+        Ready
+    };
+
     bool fileActionPrivate(const QString &file, const QString &target,
-                           QStringList *mask, bool isMove, bool targetIsFile);
+                           QStringList *mask, bool isMove, bool targetIsFile,
+                           bool initTarget = true);
+
+    /**
+     * @brief prepareAction This method checks the mask and prepares the target of the file action (creates the target dir and removes the old target file).
+     * @param targetFile This is result path to the target file.
+     * @return state of the file action.
+     */
+    ActionState prepareAction(const QString &file, const QString &target,
+                              QStringList *mask, bool isMove, bool targetIsFile,
+                              bool initTarget, QString &targetFile);
+
+    /**
+     * @brief finishAction This method prints result of the file action and updates the list of deployed files.
+     * @return value of done.
+     */
+    bool finishAction(const QString &file, const QString &targetFile,
+                      bool isMove, bool done, const QString &error);
+
+    bool smartCopyPrivate(const QString &file, const QString &target,
+                          QStringList *mask, bool ifFileTarget, bool initTarget);
+
+    void collectFolder(const QString &from, const QString &to,
+                       const QStringList &filter, bool force,
+                       QVector<CopyTask> &tasks) const;
+
+    /**
+     * @brief copyTasks This method copies the batch of files on the ioJobs worker threads.
+     *  Every target directory is created once before copying.
+     *  If some tasks have same target file then only one task is executed (the last one or the first one with the noOverwrite option),
+     *  so result is same as result of the sequential copying.
+     * @param tasks This is list of files.
+     * @param listOfCopiedItems This is list of copied files in order of tasks.
+     * @param mask This is mask of copyed files.
+     * @return true if all files processed.
+     */
+    bool copyTasks(const QVector<CopyTask> &tasks,
+                   QStringList *listOfCopiedItems,
+                   QStringList *mask);
+
+    /**
+     * @brief markTargeted This method remembers the target of the file action in the incremental mode.
+     *  The files of the previous deploy that not targeted by the current deploy will be removed by the removeStaleFiles method.
+     * @param path This is path to target.
+     */
+    void markTargeted(const QString &path);
+
+    /**
+     * @brief clearFiles This method removes the deployed files and the empty deployed directories.
+     * @param paths This is list of the deployed paths.
+     * @param manifest This is records of the deployed files, used for calculation of the reclaimed bytes without stat.
+     * @return count of removed data.
+     */
+    ClearStatistic clearFiles(const QStringList &paths, const DeployManifest &manifest) const;
+
+    /**
+     * @brief collectMoveTasks This method creates tasks for moving of all files of the folder and creates all target directories.
+     * @param from This is source folder.
+     * @param to This is target folder.
+     * @param ignore This is part of the path of ignored files.
+     * @param tasks This is result list of tasks.
+     * @return true if all target directories created.
+     */
+    bool collectMoveTasks(const QString &from, const QString &to,
+                          const QString &ignore, QVector<CopyTask> &tasks);
+
+    /**
+     * @brief renameFolder This method moves the folder with one rename call. This works only if the target folder is not exists or is empty
+     *  and the target is located on the same file system.
+     * @param from This is source folder.
+     * @param to This is target folder.
+     * @return true if the folder moved.
+     */
+    bool renameFolder(const QString &from, const QString &to);
+
+    /**
+     * @brief collectLinkTasks This method creates all directories of the view and collects files that should be linked.
+     * @param from This is source folder.
+     * @param to This is target folder.
+     * @param sources This is result list of source files.
+     * @param targets This is result list of links in same order.
+     * @return true if all directories created.
+     */
+    bool collectLinkTasks(const QString &from, const QString &to,
+                          QStringList &sources, QStringList &targets) const;
+
+    /**
+     * @brief movePaths This method replaces the prefix of all deployed paths after moving of the folder.
+     * @param from This is old path of the folder.
+     * @param to This is new path of the folder.
+     */
+    void movePaths(const QString &from, const QString &to);
+
+    bool isStripCandidate(const QFileInfo &info) const;
+
+    /**
+     * @brief removeSettingsList This method removes the list of deployed files that saved into the settings by the old versions.
+     *  The list is removed only if it was read by the loadDeployemendFiles method.
+     * @param targetDir This is target directory (key of the list).
+     */
+    void removeSettingsList(const QString &targetDir);
+
+    /**
+     * @brief stripFile This method strips the elf file in process. The external strip tool is used only for files that can not be stripped by the ELF::strip method.
+     * @param file This is path to file.
+     * @return true if file stripped.
+     */
+    bool stripFile(const QString &file) const;
 
     QSet<QString> _deployedFiles;
+    /// files deployed by the previous deploy.
+    QSet<QString> _previousFiles;
+    /// targets of the current deploy.
+    QSet<QString> _targeted;
+    DeployManifest _manifest;
+    /// the list of the previous deploy is read from the settings of the old version.
+    bool _fromSettings = false;
+    /// files copied by the current deploy that not stripped yet.
+    QStringList _stripQueue;
+    /// files skipped by the current deploy because they are not changed, the debug files of them are kept by the strip step.
+    QStringList _unchangedQueue;
+    mutable QMutex _deployedFilesMutex;
+    CopyBackend _copyBackend;
 
     /**
      * @brief changeDistanation - this function create new distanation path.
@@ -79,25 +234,91 @@ public:
     bool smartCopyFile(const QString &file, const QString &target,
                        QStringList *mask = nullptr, bool ifFileTarget = false);
 
+    /**
+     * @brief copyFileList This method invoke copyFile (or smartCopyFile) for each file on the ioJobs worker threads.
+     * @param files This is list of files.
+     * @param target This is target directory.
+     * @param mask This is mask of copyed files.
+     * @param smart If this option is true then the smartCopyFile method will be used.
+     * @return true if all files processed.
+     */
+    bool copyFileList(const QStringList &files, const QString &target,
+                      QStringList *mask = nullptr, bool smart = false);
+
     bool moveFile(const QString &file, const QString &target,
                   QStringList *mask = nullptr, bool targetIsFile = false);
 
 
 
+    /**
+     * @brief moveFolder This method moves the file or the content of the folder into the target folder.
+     *  The folder is moved with one rename call when it is possible, in other cases the files are moved on the ioJobs worker threads.
+     * @param from This is source file or folder.
+     * @param to This is target folder.
+     * @param ignore This is part of the path of ignored files.
+     * @return true if all files moved.
+     */
     bool moveFolder(const QString &from, const QString &to, const QString &ignore = "");
 
-    void clear(const QString& targetDir, bool force);
+    /**
+     * @brief linkFolder This method creates the view of the folder: same tree of directories with the hard links to the source files.
+     *  Files that can not be linked (another file system) are copied. Files are processed on the ioJobs worker threads.
+     *  The source folder is not changed and the view is not added to the deployed files.
+     * @note The links share the content and the permissions with the source, so the files of the view must not be modified in place.
+     * @param from This is source folder.
+     * @param to This is target folder. Existing files with same names are replaced.
+     * @return true if all files linked or copied.
+     */
+    bool linkFolder(const QString &from, const QString &to);
+
+    /**
+     * @brief clear This method removes files of the previous deploy.
+     *  The files are removed on the ioJobs worker threads and then empty directories are removed from the deepest one.
+     * @param targetDir This is target directory.
+     * @param force If this option is true then the whole target directory will be removed.
+     * @return count of removed files, directories and bytes. The force removing is not counted.
+     */
+    ClearStatistic clear(const QString& targetDir, bool force);
 
 
     QStringList getDeployedFilesStringList() const;
     QSet<QString> getDeployedFiles() const;
 
     bool strip(const QString &dir) const;
+
+    /**
+     * @brief stripDeployedFiles This method strips the files copied after the previous call of this method.
+     *  The files are stripped on the jobs worker threads, files without the symbol table and the debug sections are skipped.
+     * @param targetDir This is root of the deployed files.
+     * @param debugDir This is directory of the debug files. If this value is not empty then the debug information
+     *  of every file is saved into the debugDir/<path relative the targetDir>.debug file.
+     *  The debug files of the previous deploy are kept for the files skipped by the incremental deploy.
+     * @return true if all files stripped.
+     */
+    bool stripDeployedFiles(const QString &targetDir = "", const QString &debugDir = "");
     bool addToDeployed(const QString& path);
     void removeFromDeployed(const QString& path);
 
     void saveDeploymendFiles(const QString &targetDir);
     void loadDeployemendFiles(const QString &targetDir);
+
+    /**
+     * @brief removeStaleFiles This method removes files of the previous deploy that not deployed again.
+     *  This method works only in the incremental mode.
+     * @return count of removed files.
+     */
+    int removeStaleFiles();
+
+    /**
+     * @brief manifest This method returns records of the copied files.
+     */
+    DeployManifest manifest() const;
+
+    /**
+     * @brief copyBackend This method returns backend used for copying of the all files.
+     * @return reference to copy backend.
+     */
+    CopyBackend& copyBackend();
 };
 
 #endif // COPYPASTEMANAGER_H
@@ -19,37 +19,98 @@ bool IgnoreRule::checkOnlytext(const QString &lib) {
 }
 
 IgnoreRule::IgnoreRule() {
-
+    compile();
 }
 
 void IgnoreRule::addRule(const IgnoreData &rule) {
     _data.push_back(rule);
+    compile();
 }
 
-bool IgnoreRule::check(const LibInfo &info, const QString& ignoreLabel) const {
-    if (info.fullPath().contains(ignoreLabel, ONLY_WIN_CASE_INSENSIATIVE)) {
-        QuasarAppUtils::Params::log(info.fullPath() + " ignored by filter" + ignoreLabel);
-        return true;
+void IgnoreRule::compile() {
+    _compiled = QSharedPointer<Compiled>::create();
+
+    for (int i = 0; i < _data.size(); ++i) {
+        _compiled->labels.addPattern(_data.at(i).label, i);
     }
 
-    return false;
+    _compiled->labels.build();
 }
 
-const IgnoreData* IgnoreRule::isIgnore(const LibInfo &info) const {
+QString IgnoreRule::envPath(const QString &fullPath) const {
+    {
+        QReadLocker locker(&_compiled->lock);
+        auto it = _compiled->envPaths.constFind(fullPath);
+        if (it != _compiled->envPaths.constEnd()) {
+            return it.value();
+        }
+    }
+
+    QString result = Envirement::envPath(fullPath);
 
-    for (const auto &ignore : _data) {
+    QWriteLocker locker(&_compiled->lock);
+    _compiled->envPaths.insert(fullPath, result);
+
+    return result;
+}
+
+int IgnoreRule::findRule(const LibInfo &info) const {
+    const QString fullPath = info.fullPath();
+
+    // the matcher returns rules in order of adding, so the first suitable rule is same as in the list of rules.
+    const auto candidates = _compiled->labels.matches(fullPath);
+
+    for (int index : candidates) {
+        const auto &ignore = _data.at(index);
 
         bool checkPlatform = ((ignore.platform & info.getPlatform()) == info.getPlatform()) || ignore.platform == UnknownPlatform;
         bool checkPriority = (ignore.prority <= info.getPriority()) || ignore.prority == NotFile;
-        bool checkEnvirement = !ignore.enfirement.size() || ignore.enfirement.inThisEnvirement(info.fullPath());
 
-        if (checkPlatform && checkPriority && checkEnvirement && check(info, ignore.label)) {
-            return &ignore;
+        if (!checkPlatform || !checkPriority) {
+            continue;
         }
 
+        if (!ignore.enfirement.size() || ignore.enfirement.containsEnvPath(envPath(fullPath))) {
+            return index;
+        }
     }
 
-    return nullptr;
+    return -1;
+}
+
+const IgnoreData* IgnoreRule::isIgnore(const LibInfo &info) const {
+    const QString key = QString("%0:%1:%2").
+            arg(info.getPlatform()).
+            arg(info.getPriority()).
+            arg(info.fullPath());
+
+    int index = -1;
+    bool cached = false;
+
+    {
+        QReadLocker locker(&_compiled->lock);
+        auto it = _compiled->results.constFind(key);
+        if (it != _compiled->results.constEnd()) {
+            index = it.value();
+            cached = true;
+        }
+    }
+
+    if (!cached) {
+        index = findRule(info);
+
+        QWriteLocker locker(&_compiled->lock);
+        _compiled->results.insert(key, index);
+    }
+
+    if (index < 0) {
+        return nullptr;
+    }
+
+    const auto &ignore = _data.at(index);
+    QuasarAppUtils::Params::log(info.fullPath() + " ignored by filter" + ignore.label);
+
+    return &ignore;
 }
 
 IgnoreData::IgnoreData(const QString &label) {
@@ -8,9 +8,13 @@
 #ifndef IGNORERULE_H
 #define IGNORERULE_H
 
+#include "ahocorasick.h"
 #include "envirement.h"
 #include "libinfo.h"
 
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSharedPointer>
 #include <QString>
 #include <deploycore.h>
 
@@ -32,11 +36,30 @@ struct IgnoreData{
 class IgnoreRule
 {
 private:
+    /**
+     * @brief The Compiled struct contains the labels of all rules compiled into one matcher
+     *  and the cache of results. The cache is shared between copies of the rule set and is reset by the addRule method.
+     */
+    struct Compiled {
+        AhoCorasick labels = AhoCorasick(ONLY_WIN_CASE_INSENSIATIVE);
+
+        /// the normalized directories of the checked files (see Envirement::envPath).
+        QHash<QString, QString> envPaths;
+
+        /// the index of rule for each checked library or -1 if the library is not ignored.
+        QHash<QString, int> results;
+        QReadWriteLock lock;
+    };
+
     QList<IgnoreData> _data;
+    QSharedPointer<Compiled> _compiled;
 
     bool checkOnlytext(const QString& lib);
 
-    bool check(const LibInfo &info, const QString &ignoreLabel) const;
+    void compile();
+    QString envPath(const QString& fullPath) const;
+    int findRule(const LibInfo &info) const;
+
 public:
     IgnoreRule();
     void addRule(const IgnoreData& rule);
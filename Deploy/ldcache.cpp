@@ -0,0 +1,220 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "ldcache.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <cstring>
+
+namespace {
+
+const char OLD_MAGIC[] = "ld.so-1.7.0";
+const char NEW_MAGIC[] = "glibc-ld.so.cache";
+const char NEW_VERSION[] = "1.1";
+
+// sizes of the structures from the glibc sources (sysdeps/generic/dl-cache.h)
+const quint64 OLD_HEADER_SIZE = 16;
+const quint64 OLD_ENTRY_SIZE = 12;
+const quint64 NEW_HEADER_SIZE = 48;
+const quint64 NEW_ENTRY_SIZE = 24;
+
+const qint32 FLAG_TYPE_MASK = 0x00ff;
+const qint32 FLAG_ELF_LIBC6 = 0x0003;
+
+const qint32 FLAG_ARCH_MASK = 0xff00;
+const qint32 FLAG_X8664_LIB64 = 0x0300;
+const qint32 FLAG_ARM_LIBHF = 0x0900;
+const qint32 FLAG_AARCH64_LIB64 = 0x0a00;
+const qint32 FLAG_ARM_LIBSF = 0x0b00;
+
+template<typename T>
+T readValue(const uchar *data, quint64 offset) {
+    T value;
+    memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+bool contains(quint64 size, quint64 offset, quint64 length) {
+    return offset <= size && length <= size - offset;
+}
+
+QString readString(const uchar *data, quint64 size, quint64 offset) {
+    if (offset >= size) {
+        return {};
+    }
+
+    auto begin = reinterpret_cast<const char*>(data + offset);
+    return QString::fromLocal8Bit(begin, static_cast<int>(qstrnlen(begin, static_cast<uint>(size - offset))));
+}
+
+Platform platformOf(qint32 flags) {
+    if ((flags & FLAG_TYPE_MASK) != FLAG_ELF_LIBC6) {
+        return UnknownPlatform;
+    }
+
+    switch (flags & FLAG_ARCH_MASK) {
+    case 0: return Unix_x86_32;
+    case FLAG_X8664_LIB64: return Unix_x86_64;
+    case FLAG_ARM_LIBHF:
+    case FLAG_ARM_LIBSF: return Unix_ARM_32;
+    case FLAG_AARCH64_LIB64: return Unix_ARM_64;
+    default: return UnknownPlatform;
+    }
+}
+
+}
+
+LdCache::LdCache() {
+
+}
+
+QString LdCache::defaultLocation() {
+    return "/etc/ld.so.cache";
+}
+
+bool LdCache::load(const QString &path) {
+    _entries.clear();
+    _dirs.clear();
+    _size = 0;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const quint64 size = static_cast<quint64>(file.size());
+    const uchar *data = file.map(0, file.size());
+    if (!data) {
+        return false;
+    }
+
+    bool result = false;
+    quint64 newOffset = 0;
+
+    if (contains(size, 0, sizeof(OLD_MAGIC) - 1) &&
+            !memcmp(data, OLD_MAGIC, sizeof(OLD_MAGIC) - 1)) {
+
+        if (!parseOld(data, size, newOffset)) {
+            return false;
+        }
+
+        result = true;
+
+        // the new format can follow the old format, it is aligned as the new entries.
+        newOffset = (newOffset + 7) & ~quint64(7);
+    }
+
+    if (contains(size, newOffset, NEW_HEADER_SIZE) &&
+            !memcmp(data + newOffset, NEW_MAGIC, sizeof(NEW_MAGIC) - 1) &&
+            !memcmp(data + newOffset + sizeof(NEW_MAGIC) - 1, NEW_VERSION, sizeof(NEW_VERSION) - 1)) {
+
+        // the new format contains same libraries as the old format, so prefer the new.
+        _entries.clear();
+        _dirs.clear();
+        _size = 0;
+
+        result = parseNew(data, size, newOffset);
+    }
+
+    return result;
+}
+
+bool LdCache::parseOld(const uchar *data, quint64 size, quint64 &endOfOld) {
+    if (!contains(size, 0, OLD_HEADER_SIZE)) {
+        return false;
+    }
+
+    const quint32 count = readValue<quint32>(data, 12);
+    const quint64 strings = OLD_HEADER_SIZE + count * OLD_ENTRY_SIZE;
+    if (!contains(size, OLD_HEADER_SIZE, count * OLD_ENTRY_SIZE)) {
+        return false;
+    }
+
+    for (quint32 i = 0; i < count; ++i) {
+        const quint64 entry = OLD_HEADER_SIZE + i * OLD_ENTRY_SIZE;
+
+        // the string offsets of the old format are relative to the end of entries.
+        addEntry(readValue<qint32>(data, entry),
+                 readString(data, size, strings + readValue<quint32>(data, entry + 4)),
+                 readString(data, size, strings + readValue<quint32>(data, entry + 8)));
+    }
+
+    endOfOld = strings;
+    return true;
+}
+
+bool LdCache::parseNew(const uchar *data, quint64 size, quint64 offset) {
+    const quint32 count = readValue<quint32>(data, offset + 20);
+    if (!contains(size, offset + NEW_HEADER_SIZE, count * NEW_ENTRY_SIZE)) {
+        return false;
+    }
+
+    // the string offsets of the new format are relative to the begin of the new header.
+    const uchar *base = data + offset;
+    const quint64 baseSize = size - offset;
+
+    for (quint32 i = 0; i < count; ++i) {
+        const quint64 entry = NEW_HEADER_SIZE + i * NEW_ENTRY_SIZE;
+
+        addEntry(readValue<qint32>(base, entry),
+                 readString(base, baseSize, readValue<quint32>(base, entry + 4)),
+                 readString(base, baseSize, readValue<quint32>(base, entry + 8)));
+    }
+
+    return true;
+}
+
+void LdCache::addEntry(qint32 flags, const QString &name, const QString &path) {
+    if (name.isEmpty() || path.isEmpty()) {
+        return;
+    }
+
+    Entry entry;
+    entry.path = path;
+    entry.platform = platformOf(flags);
+
+    _entries[name].push_back(entry);
+    _size++;
+
+    const QString dir = QFileInfo(path).path();
+    if (!_dirs.contains(dir)) {
+        _dirs.push_back(dir);
+    }
+}
+
+bool LdCache::isLoaded() const {
+    return _size;
+}
+
+QString LdCache::find(const QString &libName, Platform platform) const {
+    auto it = _entries.constFind(libName);
+    if (it == _entries.constEnd()) {
+        return "";
+    }
+
+    for (const auto &entry : it.value()) {
+        if (platform == UnknownPlatform || entry.platform == platform) {
+            return entry.path;
+        }
+    }
+
+    return "";
+}
+
+bool LdCache::contains(const QString &libName) const {
+    return _entries.contains(libName);
+}
+
+QStringList LdCache::dirs() const {
+    return _dirs;
+}
+
+int LdCache::size() const {
+    return _size;
+}
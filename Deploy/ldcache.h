@@ -0,0 +1,78 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef LDCACHE_H
+#define LDCACHE_H
+
+#include "deploy_global.h"
+#include "deploycore.h"
+
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief The LdCache class is reader of the ld.so.cache file of the dynamic linker.
+ * Supports the old (ld.so-1.7.0) and the new (glibc-ld.so.cache1.1) formats of cache.
+ * The directories of the cached libraries are used as the system library directories instead of the recursive walk of the /lib and /usr/lib,
+ *  and the libraries that are not found in the environment are resolved by the cache same as the dynamic linker.
+ */
+class DEPLOYSHARED_EXPORT LdCache
+{
+public:
+    LdCache();
+
+    /**
+     * @brief defaultLocation This method returns path to the cache of the system dynamic linker.
+     */
+    static QString defaultLocation();
+
+    /**
+     * @brief load This method reads all entries of the cache file.
+     * @param path This is path to the cache file.
+     * @return true if the cache file loaded successful.
+     */
+    bool load(const QString &path = defaultLocation());
+
+    bool isLoaded() const;
+
+    /**
+     * @brief find This method returns the path to which the library is resolved by the dynamic linker.
+     * @param libName This is name of the library (soname).
+     * @param platform This is required platform. If platform is UnknownPlatform then returns the first found library.
+     * @return path to library or empty string if the library is not found.
+     */
+    QString find(const QString &libName, Platform platform = UnknownPlatform) const;
+
+    /**
+     * @brief contains This method returns true if the library is system library.
+     */
+    bool contains(const QString &libName) const;
+
+    /**
+     * @brief dirs This method returns all directories of the cached libraries.
+     */
+    QStringList dirs() const;
+
+    int size() const;
+
+private:
+    struct Entry {
+        QString path;
+        Platform platform = UnknownPlatform;
+    };
+
+    void addEntry(qint32 flags, const QString& name, const QString& path);
+    bool parseNew(const uchar *data, quint64 size, quint64 offset);
+    bool parseOld(const uchar *data, quint64 size, quint64 &endOfOld);
+
+    QHash<QString, QVector<Entry>> _entries;
+    QStringList _dirs;
+    int _size = 0;
+};
+
+#endif // LDCACHE_H
@@ -0,0 +1,247 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "libgraph.h"
+
+#include <algorithm>
+
+LibGraph::LibGraph() {
+
+}
+
+LibGraph::NodeId LibGraph::find(const QString &fullPath) const {
+    return _index.value(fullPath, InvalidNode);
+}
+
+LibGraph::NodeId LibGraph::insert(const LibInfo &info) {
+    const QString fullPath = info.fullPath();
+    auto it = _index.constFind(fullPath);
+    if (it != _index.constEnd()) {
+        return it.value();
+    }
+
+    LibInfo node = info;
+    node.setName(intern(info.getName()));
+    node.setPath(intern(info.getPath()));
+    node.setQtPath(intern(info.getQtPath()));
+
+    QSet<QString> dependencies;
+    for (const auto &dep : info.getDependncies()) {
+        dependencies.insert(intern(dep));
+    }
+    node.setDependncies(dependencies);
+
+    NodeId id = static_cast<NodeId>(_nodes.size());
+    _nodes.push_back(node);
+    _blocks.push_back({});
+    _components.push_back(InvalidNode);
+    _index.insert(intern(fullPath), id);
+
+    return id;
+}
+
+const LibInfo &LibGraph::node(NodeId id) const {
+    return _nodes.at(static_cast<int>(id));
+}
+
+bool LibGraph::isResolved(NodeId id) const {
+    return _blocks.at(static_cast<int>(id)).resolved;
+}
+
+void LibGraph::setEdges(NodeId id, const QVector<NodeId> &edges, const QVector<NodeId> &shallowEdges) {
+    auto &block = _blocks[static_cast<int>(id)];
+    if (block.resolved) {
+        return;
+    }
+
+    if (shallowEdges.size()) {
+        _shallowEdges.insert(id, shallowEdges);
+    }
+
+    block.offset = static_cast<quint32>(_edges.size());
+    block.count = static_cast<quint32>(edges.size());
+    block.resolved = true;
+
+    _edges += edges;
+}
+
+LibGraph::Edges LibGraph::edges(NodeId id) const {
+    const auto &block = _blocks.at(static_cast<int>(id));
+    if (!block.count) {
+        return {};
+    }
+
+    const NodeId *first = _edges.constData() + block.offset;
+    return {first, first + block.count};
+}
+
+QBitArray LibGraph::closure(NodeId id) {
+    condense(id);
+    return _closures.at(static_cast<int>(_components.at(static_cast<int>(id))));
+}
+
+void LibGraph::condense(NodeId root) {
+    if (_components.at(static_cast<int>(root)) != InvalidNode) {
+        return;
+    }
+
+    struct Frame {
+        NodeId node;
+        int edge;
+    };
+
+    const int count = _nodes.size();
+    QVector<quint32> index(count, InvalidNode);
+    QVector<quint32> low(count, InvalidNode);
+    QBitArray onStack(count);
+    QVector<NodeId> stack;
+    QVector<Frame> callStack;
+    quint32 counter = 0;
+
+    auto open = [&](NodeId node) {
+        index[static_cast<int>(node)] = low[static_cast<int>(node)] = counter++;
+        onStack.setBit(static_cast<int>(node));
+        stack.push_back(node);
+        callStack.push_back({node, 0});
+    };
+
+    open(root);
+
+    while (callStack.size()) {
+        const NodeId node = callStack.last().node;
+        const Edges nodeEdges = edges(node);
+        const int edge = callStack.last().edge;
+
+        if (edge < nodeEdges.size()) {
+            callStack.last().edge++;
+            const NodeId dep = nodeEdges.first[edge];
+
+            // components found by previous calls are already closed.
+            if (_components.at(static_cast<int>(dep)) != InvalidNode) {
+                continue;
+            }
+
+            if (index.at(static_cast<int>(dep)) == InvalidNode) {
+                open(dep);
+            } else if (onStack.testBit(static_cast<int>(dep))) {
+                low[static_cast<int>(node)] = std::min(low.at(static_cast<int>(node)),
+                                                       index.at(static_cast<int>(dep)));
+            }
+
+            continue;
+        }
+
+        callStack.removeLast();
+
+        if (callStack.size()) {
+            const int parent = static_cast<int>(callStack.last().node);
+            low[parent] = std::min(low.at(parent), low.at(static_cast<int>(node)));
+        }
+
+        if (low.at(static_cast<int>(node)) != index.at(static_cast<int>(node))) {
+            continue;
+        }
+
+        // the node is root of component, Tarjan algorithm finds components in reverse topological order,
+        // so the closures of all dependencies of component are already computed.
+        const quint32 component = static_cast<quint32>(_closures.size());
+        QVector<NodeId> members;
+        NodeId member;
+        do {
+            member = stack.takeLast();
+            onStack.clearBit(static_cast<int>(member));
+            _components[static_cast<int>(member)] = component;
+            members.push_back(member);
+        } while (member != node);
+
+        QBitArray result(count);
+        bool cyclic = members.size() > 1;
+
+        for (NodeId item : qAsConst(members)) {
+            for (NodeId dep : edges(item)) {
+                const quint32 depComponent = _components.at(static_cast<int>(dep));
+                if (depComponent == component) {
+                    cyclic = true;
+                    continue;
+                }
+
+                result.setBit(static_cast<int>(dep));
+                result |= _closures.at(static_cast<int>(depComponent));
+            }
+
+            // the shallow dependencies are not traversed, so they do not change the components.
+            for (NodeId dep : _shallowEdges.value(item)) {
+                result.setBit(static_cast<int>(dep));
+            }
+        }
+
+        if (cyclic) {
+            for (NodeId item : qAsConst(members)) {
+                result.setBit(static_cast<int>(item));
+            }
+        }
+
+        _closures.push_back(result);
+    }
+}
+
+int LibGraph::size() const {
+    return _nodes.size();
+}
+
+void LibGraph::clear() {
+    _strings.clear();
+    _index.clear();
+    _nodes.clear();
+    _blocks.clear();
+    _edges.clear();
+    _shallowEdges.clear();
+    _components.clear();
+    _closures.clear();
+}
+
+QString LibGraph::intern(const QString &string) {
+    auto it = _strings.constFind(string);
+    if (it != _strings.constEnd()) {
+        return *it;
+    }
+
+    return *_strings.insert(string);
+}
+
+LibGraphView::LibGraphView(const LibGraph *graph, const QBitArray &nodes):
+    _graph(graph),
+    _nodes(nodes) {
+
+}
+
+LibGraphView::const_iterator LibGraphView::begin() const {
+    return const_iterator(_graph, &_nodes, 0);
+}
+
+LibGraphView::const_iterator LibGraphView::end() const {
+    return const_iterator(_graph, &_nodes, _nodes.size());
+}
+
+int LibGraphView::size() const {
+    return _nodes.count(true);
+}
+
+bool LibGraphView::isEmpty() const {
+    return !size();
+}
+
+bool LibGraphView::contains(const QString &fullPath) const {
+    if (!_graph) {
+        return false;
+    }
+
+    auto id = _graph->find(fullPath);
+    return id != LibGraph::InvalidNode &&
+            static_cast<int>(id) < _nodes.size() &&
+            _nodes.testBit(static_cast<int>(id));
+}
@@ -0,0 +1,163 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef LIBGRAPH_H
+#define LIBGRAPH_H
+
+#include "deploy_global.h"
+#include "libinfo.h"
+
+#include <QBitArray>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+/**
+ * @brief The LibGraph class is store of the dependencies graph.
+ * Each library is saved only once and gets the integer id. All strings of the libraries are interned,
+ * and the edges of all nodes are stored in the one flat array.
+ */
+class DEPLOYSHARED_EXPORT LibGraph
+{
+public:
+    typedef quint32 NodeId;
+    static constexpr NodeId InvalidNode = 0xFFFFFFFF;
+
+    /**
+     * @brief The Edges struct is range of the dependencies of one node.
+     */
+    struct Edges {
+        const NodeId *first = nullptr;
+        const NodeId *last = nullptr;
+
+        const NodeId *begin() const { return first; }
+        const NodeId *end() const { return last; }
+        int size() const { return static_cast<int>(last - first); }
+    };
+
+    LibGraph();
+
+    /**
+     * @brief find This method returns id of the library.
+     * @param fullPath This is full path to library.
+     * @return id of node or InvalidNode if the library is not added.
+     */
+    NodeId find(const QString &fullPath) const;
+
+    /**
+     * @brief insert This method adds the library into graph.
+     * @param info This is information of the library.
+     * @return id of new node or id of existing node with same full path.
+     */
+    NodeId insert(const LibInfo &info);
+
+    /**
+     * @brief node This method returns information of the node.
+     * @note The returned reference is invalid after the insert method.
+     */
+    const LibInfo& node(NodeId id) const;
+
+    /**
+     * @brief isResolved This method returns true if the dependencies of node already set.
+     */
+    bool isResolved(NodeId id) const;
+
+    /**
+     * @brief setEdges This method sets the dependencies of node. Each node can be resolved only once.
+     * @param id This is id of node.
+     * @param edges This is list of the dependencies.
+     * @param shallowEdges This is list of the dependencies that included into closure of the node without their own dependencies.
+     */
+    void setEdges(NodeId id, const QVector<NodeId> &edges, const QVector<NodeId> &shallowEdges = {});
+    Edges edges(NodeId id) const;
+
+    /**
+     * @brief closure This method returns all nodes that reachable from the node as bitset over ids of nodes.
+     * The node is included only if it reachable from its own dependencies.
+     * @note The closures are computed once per strongly connected component of graph,
+     *  so the node and all reachable nodes should be resolved before calling of this method.
+     */
+    QBitArray closure(NodeId id);
+
+    int size() const;
+    void clear();
+
+private:
+    struct EdgeBlock {
+        quint32 offset = 0;
+        quint32 count = 0;
+        bool resolved = false;
+    };
+
+    QString intern(const QString &string);
+
+    /**
+     * @brief condense This method finds the strongly connected components (Tarjan algorithm)
+     *  of the new nodes that reachable from the root and computes the closure of each component.
+     */
+    void condense(NodeId root);
+
+    QSet<QString> _strings;
+    QHash<QString, NodeId> _index;
+    QVector<LibInfo> _nodes;
+    QVector<EdgeBlock> _blocks;
+    QVector<NodeId> _edges;
+
+    QHash<NodeId, QVector<NodeId>> _shallowEdges;
+
+    QVector<quint32> _components;
+    QVector<QBitArray> _closures;
+};
+
+/**
+ * @brief The LibGraphView class is lightweight list of the nodes of graph.
+ * @note The view is invalid after clearing of the graph.
+ */
+class DEPLOYSHARED_EXPORT LibGraphView
+{
+public:
+    class const_iterator {
+    public:
+        const_iterator(const LibGraph *graph, const QBitArray *nodes, int index):
+            _graph(graph), _nodes(nodes), _index(index) {
+            skip();
+        }
+
+        const LibInfo& operator*() const { return _graph->node(static_cast<LibGraph::NodeId>(_index)); }
+        const LibInfo* operator->() const { return &operator*(); }
+        const_iterator& operator++() { ++_index; skip(); return *this; }
+        bool operator==(const const_iterator &other) const { return _index == other._index; }
+        bool operator!=(const const_iterator &other) const { return _index != other._index; }
+
+    private:
+        void skip() {
+            while (_index < _nodes->size() && !_nodes->testBit(_index)) {
+                ++_index;
+            }
+        }
+
+        const LibGraph *_graph = nullptr;
+        const QBitArray *_nodes = nullptr;
+        int _index = 0;
+    };
+
+    LibGraphView() = default;
+    LibGraphView(const LibGraph *graph, const QBitArray &nodes);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    int size() const;
+    bool isEmpty() const;
+    bool contains(const QString &fullPath) const;
+
+private:
+    const LibGraph *_graph = nullptr;
+    QBitArray _nodes;
+};
+
+#endif // LIBGRAPH_H
@@ -28,10 +28,6 @@ bool operator >(const LibInfo &left, const LibInfo &right) {
     return left.priority > right.priority;
 }
 
-const QSet<LibInfo> &LibInfo::getAllDep() const {
-    return allDep;
-}
-
 Platform LibInfo::getPlatform() const {
     return platform;
 }
@@ -122,7 +118,6 @@ void LibInfo::clear() {
     qtPath = "";
     platform = Platform::UnknownPlatform;
     dependncies.clear();
-    allDep.clear();
 }
 
 bool LibInfo::isValid() const {
@@ -130,10 +125,6 @@ bool LibInfo::isValid() const {
             name.size() && path.size();
 }
 
-bool LibInfo::isScaned() const {
-    return allDep.size();
-}
-
 uint qHash(const LibInfo &info) {
     return qHash(info.fullPath());
 }
@@ -12,8 +12,6 @@
 
 class DEPLOYSHARED_EXPORT LibInfo {
 private:
-    QSet<LibInfo> allDep;
-
     Platform platform = Platform::UnknownPlatform;
     QString name;
     QString path;
@@ -35,10 +33,8 @@ public:
     void clear();
 
     bool isValid() const;
-    bool isScaned() const;
 
     friend class DependenciesScanner;
-    const QSet<LibInfo>& getAllDep() const;
     Platform getPlatform() const;
     void setPlatform(const Platform &value);
     QString getName() const;
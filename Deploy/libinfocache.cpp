@@ -0,0 +1,278 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "libinfocache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <quasarapp.h>
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+#define CACHE_MAGIC     0x43514c43 // CQLC
+#define CACHE_VERSION   1
+
+LibInfoCache::LibInfoCache() {
+    _location = defaultLocation();
+}
+
+QString LibInfoCache::defaultLocation() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/libinfo.cache";
+}
+
+QString LibInfoCache::location() const {
+    QReadLocker locker(&_lock);
+    return _location;
+}
+
+void LibInfoCache::setLocation(const QString &location) {
+    QWriteLocker locker(&_lock);
+    _location = location;
+}
+
+bool LibInfoCache::load() {
+    QWriteLocker locker(&_lock);
+
+    QFile file(_location);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> count;
+
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+        QuasarAppUtils::Params::log("The cache of libraries has a unsupported format and will be rebuilt: " + _location,
+                                    QuasarAppUtils::Debug);
+        return false;
+    }
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QByteArray path, name, qtPath;
+        QList<QByteArray> dependencies;
+        qint32 platform = 0;
+        quint8 winApi = 0;
+        Record record;
+
+        stream >> path
+               >> record.identity.size
+               >> record.identity.mtime
+               >> record.identity.inode
+               >> platform
+               >> name
+               >> dependencies
+               >> qtPath
+               >> winApi;
+
+        if (stream.status() != QDataStream::Ok) {
+            break;
+        }
+
+        auto filePath = QString::fromUtf8(path);
+        if (_records.contains(filePath)) {
+            continue;
+        }
+
+        record.info.setPlatform(static_cast<Platform>(platform));
+        record.info.setName(QString::fromUtf8(name));
+        record.info.setPath(QFileInfo(filePath).absolutePath());
+        record.info.setQtPath(QString::fromUtf8(qtPath));
+        record.info.setWinApi(static_cast<WinAPI>(winApi));
+
+        for (const auto &dep : qAsConst(dependencies)) {
+            record.info.addDependncies(QString::fromUtf8(dep));
+        }
+
+        _records.insert(filePath, record);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        QuasarAppUtils::Params::log("The cache of libraries is damaged: " + _location,
+                                    QuasarAppUtils::Warning);
+        return false;
+    }
+
+    return true;
+}
+
+bool LibInfoCache::save() {
+    QWriteLocker locker(&_lock);
+
+    evict();
+
+    if (!_changed) {
+        return true;
+    }
+
+    if (!QDir().mkpath(QFileInfo(_location).absolutePath())) {
+        return false;
+    }
+
+    QSaveFile file(_location);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+
+    stream << static_cast<quint32>(CACHE_MAGIC)
+           << static_cast<quint32>(CACHE_VERSION)
+           << static_cast<quint32>(_records.size());
+
+    for (auto it = _records.cbegin(); it != _records.cend(); ++it) {
+        const auto &record = it.value();
+
+        QList<QByteArray> dependencies;
+        const auto deps = record.info.getDependncies();
+        for (const auto &dep : deps) {
+            dependencies.push_back(dep.toUtf8());
+        }
+
+        stream << it.key().toUtf8()
+               << record.identity.size
+               << record.identity.mtime
+               << record.identity.inode
+               << static_cast<qint32>(record.info.getPlatform())
+               << record.info.getName().toUtf8()
+               << dependencies
+               << record.info.getQtPath().toUtf8()
+               << static_cast<quint8>(record.info.getWinApi());
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        return false;
+    }
+
+    _changed = false;
+    return true;
+}
+
+bool LibInfoCache::purge() {
+    QWriteLocker locker(&_lock);
+
+    _records.clear();
+    _changed = false;
+
+    if (!QFile::exists(_location)) {
+        return true;
+    }
+
+    return QFile::remove(_location);
+}
+
+bool LibInfoCache::find(const QString &file, LibInfo &info) const {
+    FileIdentity identity;
+
+    {
+        QReadLocker locker(&_lock);
+        if (!_records.contains(file)) {
+            return false;
+        }
+    }
+
+    if (!fileIdentity(file, identity)) {
+        return false;
+    }
+
+    QWriteLocker locker(&_lock);
+    auto it = _records.constFind(file);
+    if (it == _records.constEnd() || !(it->identity == identity)) {
+        return false;
+    }
+
+    it->used = true;
+    info = it->info;
+    return true;
+}
+
+void LibInfoCache::insert(const QString &file, const LibInfo &info) {
+    Record record;
+    if (!fileIdentity(file, record.identity)) {
+        return;
+    }
+
+    record.info = info;
+    record.used = true;
+
+    QWriteLocker locker(&_lock);
+    _records.insert(file, record);
+    _changed = true;
+}
+
+void LibInfoCache::evict() {
+    bool used = std::any_of(_records.cbegin(), _records.cend(), [](const Record &record) {
+        return record.used;
+    });
+
+    // the cache is not used by this run, so there is no information about actual records.
+    if (!used) {
+        return;
+    }
+
+    for (auto it = _records.begin(); it != _records.end();) {
+        if (it->used) {
+            ++it;
+            continue;
+        }
+
+        it = _records.erase(it);
+        _changed = true;
+    }
+}
+
+int LibInfoCache::size() const {
+    QReadLocker locker(&_lock);
+    return _records.size();
+}
+
+bool LibInfoCache::fileIdentity(const QString &file, FileIdentity &identity) {
+#ifdef Q_OS_UNIX
+    struct stat st;
+    if (::stat(QFile::encodeName(file).constData(), &st) != 0) {
+        return false;
+    }
+
+    identity.size = static_cast<qint64>(st.st_size);
+    identity.inode = static_cast<quint64>(st.st_ino);
+#ifdef Q_OS_LINUX
+    identity.mtime = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#else
+    identity.mtime = static_cast<qint64>(st.st_mtime) * 1000000000;
+#endif
+
+    return true;
+#else
+    QFileInfo info(file);
+    if (!info.isFile()) {
+        return false;
+    }
+
+    identity.size = info.size();
+    identity.mtime = info.lastModified().toMSecsSinceEpoch();
+    identity.inode = 0;
+
+    return true;
+#endif
+}
+
+bool LibInfoCache::FileIdentity::operator ==(const FileIdentity &other) const {
+    return size == other.size && mtime == other.mtime && inode == other.inode;
+}
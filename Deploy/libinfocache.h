@@ -0,0 +1,106 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef LIBINFOCACHE_H
+#define LIBINFOCACHE_H
+
+#include "deploy_global.h"
+#include "libinfo.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+
+/**
+ * @brief The LibInfoCache class is persistent cache of the parsed libraries.
+ * Each record is keyed by the path, the size, the modification time and the inode of file,
+ * so changed files will be parsed again.
+ * The records that are not used by the current run (including the records of the removed and the changed files) are removed while saving.
+ * @note All methods of this class are thread-safe.
+ */
+class DEPLOYSHARED_EXPORT LibInfoCache
+{
+public:
+    LibInfoCache();
+
+    /**
+     * @brief defaultLocation This method return path to the cache file in the user cache directory.
+     * @return path to cache file.
+     */
+    static QString defaultLocation();
+
+    QString location() const;
+    void setLocation(const QString &location);
+
+    /**
+     * @brief load This method reads all records from the cache file.
+     * @return true if the cache file loaded successful.
+     */
+    bool load();
+
+    /**
+     * @brief save This method writes all records into the cache file. If the cache is not changed then this method do nothing.
+     *  The records that are not found or inserted after loading are removed before saving.
+     *  If no record is used then all records are kept.
+     * @return true if the cache file saved successful.
+     */
+    bool save();
+
+    /**
+     * @brief purge This method removes all records and the cache file.
+     * @return true if the cache file removed successful.
+     */
+    bool purge();
+
+    /**
+     * @brief find This method search record of the file.
+     * @param file This is path to file.
+     * @param info This is result information of the file.
+     * @return true if the record is found and file is not changed after parsing.
+     */
+    bool find(const QString &file, LibInfo &info) const;
+
+    /**
+     * @brief insert This method adds record of the file.
+     * @param file This is path to file.
+     * @param info This is parsed information of the file.
+     */
+    void insert(const QString &file, const LibInfo &info);
+
+    int size() const;
+
+private:
+    struct FileIdentity {
+        qint64 size = 0;
+        qint64 mtime = 0;
+        quint64 inode = 0;
+
+        bool operator == (const FileIdentity &other) const;
+    };
+
+    struct Record {
+        FileIdentity identity;
+        LibInfo info;
+        /// the record is found or inserted after loading, it is changed only with the write lock.
+        mutable bool used = false;
+    };
+
+    /**
+     * @brief evict This method removes the records that are not used after loading.
+     * @note Use only with the write lock.
+     */
+    void evict();
+
+    static bool fileIdentity(const QString &file, FileIdentity &identity);
+
+    QHash<QString, Record> _records;
+    QString _location;
+    bool _changed = false;
+
+    mutable QReadWriteLock _lock;
+};
+
+#endif // LIBINFOCACHE_H
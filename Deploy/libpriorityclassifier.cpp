@@ -0,0 +1,146 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "libpriorityclassifier.h"
+#include "deployconfig.h"
+#include "pathutils.h"
+
+#include <QFileInfo>
+#include <quasarapp.h>
+
+LibPriorityClassifier::LibPriorityClassifier():
+    _pathMatcher(ONLY_WIN_CASE_INSENSIATIVE),
+    _nameMatcher(ONLY_WIN_CASE_INSENSIATIVE) {
+
+    compile(nullptr);
+}
+
+void LibPriorityClassifier::compile(const DeployConfig *config) {
+    QWriteLocker locker(&_lock);
+
+    _results.clear();
+    _extraDirs.clear();
+    _allowedDirs.clear();
+    _pathMatcher.clear();
+    _nameMatcher.clear();
+
+    _checkQtDir = config;
+    _noQt = QuasarAppUtils::Params::isEndable("noQt") &&
+            !QuasarAppUtils::Params::isEndable("qmake");
+
+    if (config) {
+        const QtDir &qtDir = config->qtDir;
+        const QStringList qtDirs = {
+            qtDir.getLibs(),
+            qtDir.getBins(),
+            qtDir.getLibexecs(),
+            qtDir.getPlugins(),
+            qtDir.getQmls(),
+            qtDir.getTranslations(),
+            qtDir.getResources()
+        };
+
+        for (const auto &dir: qtDirs) {
+            if (dir.size()) {
+                _pathMatcher.addPattern(dir, PathPattern::QtDir);
+            }
+        }
+
+        _extraDirs = config->extraPaths.getExtraPaths();
+        _allowedDirs = config->allowedPaths.getExtraPaths();
+
+        for (const auto &mask: config->extraPaths.getExtraPathsMasks()) {
+            _pathMatcher.addPattern(mask, PathPattern::ExtraPath);
+        }
+
+        for (const auto &mask: config->allowedPaths.getExtraPathsMasks()) {
+            _pathMatcher.addPattern(mask, PathPattern::AllowedPath);
+        }
+
+        for (const auto &mask: config->extraPaths.getExtraNamesMasks()) {
+            _nameMatcher.addPattern(mask, NamePattern::ExtraName);
+        }
+
+        for (const auto &mask: config->allowedPaths.getExtraNamesMasks()) {
+            _nameMatcher.addPattern(mask, NamePattern::AllowedName);
+        }
+    }
+
+    _pathMatcher.build();
+    _nameMatcher.build();
+}
+
+LibPriority LibPriorityClassifier::priority(const QString &lib) const {
+    {
+        QReadLocker locker(&_lock);
+        auto it = _results.constFind(lib);
+        if (it != _results.constEnd()) {
+            return it.value();
+        }
+    }
+
+    LibPriority result = classify(lib);
+
+    QWriteLocker locker(&_lock);
+    _results.insert(lib, result);
+
+    return result;
+}
+
+bool LibPriorityClassifier::isQtLib(const QString &fileName,
+                                    const QString &completeSuffix) const {
+
+    if (!completeSuffix.contains("so", Qt::CaseInsensitive) &&
+            !completeSuffix.contains("dll", Qt::CaseInsensitive)) {
+        return false;
+    }
+
+    if (!fileName.contains("Qt4", ONLY_WIN_CASE_INSENSIATIVE) &&
+            !fileName.contains("Qt5", ONLY_WIN_CASE_INSENSIATIVE) &&
+            !fileName.contains("Qt6", ONLY_WIN_CASE_INSENSIATIVE)) {
+        return false;
+    }
+
+    return !_noQt;
+}
+
+LibPriority LibPriorityClassifier::classify(const QString &lib) const {
+    QFileInfo info(lib);
+
+    if (!info.isFile()) {
+        return NotFile;
+    }
+
+    const QString fixedPath = PathUtils::fixPath(info.absoluteFilePath());
+    const QVector<int> pathMatches = _pathMatcher.matches(fixedPath);
+
+    bool qtDir = !_checkQtDir || pathMatches.contains(PathPattern::QtDir);
+    if (qtDir && isQtLib(info.fileName(), info.completeSuffix())) {
+        return QtLib;
+    }
+
+    const QString fixedDir = PathUtils::fixPath(info.absolutePath());
+    const QVector<int> nameMatches = _nameMatcher.matches(PathUtils::fixPath(info.fileName()));
+
+    if (_extraDirs.contains(fixedDir) ||
+            pathMatches.contains(PathPattern::ExtraPath) ||
+            nameMatches.contains(NamePattern::ExtraName)) {
+        return ExtraLib;
+    }
+
+    if (DeployCore::isAlienLib(lib)) {
+        return AlienLib;
+    }
+
+    if (_allowedDirs.contains(fixedDir) ||
+            pathMatches.contains(PathPattern::AllowedPath) ||
+            nameMatches.contains(NamePattern::AllowedName)) {
+        return AllowedLib;
+    }
+
+    return SystemLib;
+}
@@ -0,0 +1,76 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef LIBPRIORITYCLASSIFIER_H
+#define LIBPRIORITYCLASSIFIER_H
+
+#include "ahocorasick.h"
+#include "deploy_global.h"
+#include "deploycore.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSet>
+
+class DeployConfig;
+
+/**
+ * @brief The LibPriorityClassifier class computes the priority of the library.
+ * The library is checked in order: Qt library (see the DeployCore::isQtLib), extra, alien, allowed and system library.
+ * The directories of Qt, the extra and the allowed masks are compiled into the matchers once,
+ *  and the priority of each path is computed only once.
+ * @note The classifier uses a snapshot of the configuration, so it should be compiled again after changing of the configuration.
+ * @note The priority method is thread-safe.
+ */
+class DEPLOYSHARED_EXPORT LibPriorityClassifier
+{
+public:
+    LibPriorityClassifier();
+
+    /**
+     * @brief compile This method reads the rules of the priorities from the configuration and clears all memoized results.
+     * @param config This is deploy configuration. If the config is nullptr then only the qt names and the alien paths are checked.
+     */
+    void compile(const DeployConfig *config);
+
+    /**
+     * @brief priority This method returns priority of the library.
+     * @param lib This is path to library.
+     * @return priority of the library.
+     */
+    LibPriority priority(const QString &lib) const;
+
+private:
+    enum PathPattern {
+        QtDir,
+        ExtraPath,
+        AllowedPath
+    };
+
+    enum NamePattern {
+        ExtraName,
+        AllowedName
+    };
+
+    LibPriority classify(const QString &lib) const;
+    bool isQtLib(const QString &fileName, const QString &completeSuffix) const;
+
+    QSet<QString> _extraDirs;
+    QSet<QString> _allowedDirs;
+
+    // the matchers return the PathPattern (NamePattern) of the found patterns.
+    AhoCorasick _pathMatcher;
+    AhoCorasick _nameMatcher;
+
+    bool _checkQtDir = false;
+    bool _noQt = false;
+
+    mutable QHash<QString, LibPriority> _results;
+    mutable QReadWriteLock _lock;
+};
+
+#endif // LIBPRIORITYCLASSIFIER_H
@@ -0,0 +1,12 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+// The shared build of the zip library exports only the zip_* functions (see the ZIP_EXPORT of the zip.h),
+// so the deflate and the crc32 functions of the miniz used by the ZipWriter are compiled into the Deploy library.
+// The archive api of the miniz is used only through the zip library.
+#define MINIZ_NO_ARCHIVE_APIS
+#include "miniz.h"
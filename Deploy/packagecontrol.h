@@ -21,12 +21,13 @@ public:
     virtual ~PackageControl();
 
     /**
-     * @brief movePackage This method should be move package to new location.
+     * @brief linkPackage This method should be create the view of package in new location.
+     *  The staged data of the package is not changed, so every distribution can build own layout from same data.
      * @param package This is key of deployed package.
      * @param newLocation This is path to new location of package.
-     * @return true if data moved successful.
+     * @return true if view created successful.
      */
-    virtual bool movePackage(const QString& package,
+    virtual bool linkPackage(const QString& package,
                              const QString& newLocation) = 0;
 
     /**
@@ -9,31 +9,92 @@
 #include "deployconfig.h"
 #include "filemanager.h"
 #include "packing.h"
+#include "parallel.h"
 #include "pathutils.h"
 #include "quasarapp.h"
+#include <QAtomicInteger>
 #include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QProcess>
 #include <QThread>
+#include <algorithm>
 #include <cassert>
 
 #define TMP_PACKAGE_DIR "tmp_data"
 
-Packing::Packing(FileManager *fileManager) {
-    assert(fileManager);
+namespace {
 
-    _fileManager = fileManager;
-    _proc = new QProcess(this);
+/**
+ * @brief runCommand This function runs one packing job in own process and prints the output of the job after finish.
+ * @param cmd This is command of the distribution.
+ * @param workDir This is working directory of the process.
+ * @param jobs This is count of the threads available for the job.
+ * @param error This is description of the error, it is empty if the job finished successful.
+ * @return false if packing should be stopped.
+ */
+bool runCommand(const SystemCommandData &cmd, const QString &workDir, int jobs, QString &error) {
+    if (cmd.function) {
+        if (!cmd.function(jobs)) {
+            error = QString("Failed to %0 %1").arg(cmd.command, cmd.arguments.join(" "));
+            return false;
+        }
+
+        return true;
+    }
+
+    QProcess proc;
+    proc.setProgram(cmd.command);
+    proc.setArguments(cmd.arguments);
+    proc.setWorkingDirectory(workDir);
+
+    proc.start();
+
+    if (!proc.waitForStarted()) {
+        error = QString("%0: %1 (process error code: %2)").
+                arg(cmd.command, proc.errorString()).arg(proc.error());
+        return false;
+    }
+
+    if (!proc.waitForFinished(-1)) {
+        error = QString("%0: %1 (process error code: %2)").
+                arg(cmd.command, proc.errorString()).arg(proc.error());
+        return false;
+    }
+
+    // the output of every job is printed as one block, so the logs of the concurrent jobs are not mixed.
+    QString stdoutLog = proc.readAllStandardOutput();
+    QString erroutLog = proc.readAllStandardError();
+
+    if (stdoutLog.size())
+        QuasarAppUtils::Params::log(cmd.command + ": " + stdoutLog,
+                                    QuasarAppUtils::Info);
 
-    connect(_proc, SIGNAL(readyReadStandardError()),
-            this, SLOT(handleOutputUpdate()));
+    if (erroutLog.size())
+        QuasarAppUtils::Params::log(cmd.command + ": " + erroutLog,
+                                    QuasarAppUtils::Info);
+
+    if (proc.exitCode() != 0) {
+        error = QString("%0 %1: exit code = %2, message = %3").
+                arg(cmd.command, cmd.arguments.join(" ")).
+                arg(proc.exitCode()).
+                arg(stdoutLog + " " + erroutLog);
 
-    connect(_proc, SIGNAL(readyReadStandardOutput()),
-            this, SLOT(handleOutputUpdate()));
+        return !QuasarAppUtils::Params::isDebug();
+    }
 
+    return true;
+}
+
+}
+
+Packing::Packing(FileManager *fileManager) {
+    assert(fileManager);
+
+    _fileManager = fileManager;
 }
 
 Packing::~Packing() {
-    _proc->kill();
 }
 
 void Packing::setDistribution(const QList<iDistribution*> &pakages) {
@@ -46,6 +107,9 @@ bool Packing::create() {
         return false;
     }
 
+    // the templates are prepared one by one because they use the same file manager,
+    // every distribution has own folder, so the commands of all distributions can be run together.
+    QList<SystemCommandData> commands;
     for (auto package : qAsConst(_pakages)) {
 
         if (!package)
@@ -54,87 +118,102 @@ bool Packing::create() {
         if (!package->deployTemplate(*this))
             return false;
 
-        auto commands = package->runCmd();
-
-        for (const auto& cmd: commands) {
-            const DeployConfig *cfg = DeployCore::_config;
-
+        commands += package->runCmd();
+    }
 
-            QFileInfo cmdInfo(cmd.command);
+    if (runCommands(commands, DeployCore::_config->getTargetDir())) {
+        return false;
+    }
 
-            auto allExecRight =  QFile::ExeUser | QFile::ExeGroup | QFile::ExeOwner;
-            if (!cmdInfo.permission(allExecRight)) {
-                QFile::setPermissions(cmdInfo.absoluteFilePath(), cmdInfo.permissions() | allExecRight);
-            }
+    for (auto package : qAsConst(_pakages)) {
+        if (!package->cb()) {
+            return false;
+        }
+    }
 
-            _proc->setProgram(cmd.command);
-            _proc->setProcessEnvironment(_proc->processEnvironment());
-            _proc->setArguments(cmd.arguments);
-            _proc->setWorkingDirectory(cfg->getTargetDir());
+    if (!removePackageViews()) {
+        return false;
+    }
 
-            _proc->start();
+    for (auto package : qAsConst(_pakages)) {
+        package->removeTemplate();
+        delete package;
+    }
+    _pakages.clear();
 
-            if (!_proc->waitForStarted()) {
-                QuasarAppUtils::Params::log(_proc->errorString(), QuasarAppUtils::Error);
-                QuasarAppUtils::Params::log(QString("Process error code: %0").arg(_proc->error()),
-                                            QuasarAppUtils::Error);
-                return false;
-            }
+    const DeployConfig *cfg = DeployCore::_config;
+    return QDir(cfg->getTargetDir() + "/" + TMP_PACKAGE_DIR).removeRecursively();
+}
 
-            if (!_proc->waitForFinished(-1)) {
-                QuasarAppUtils::Params::log(_proc->errorString(), QuasarAppUtils::Error);
-                QuasarAppUtils::Params::log(QString("Process error code: %0").arg(_proc->error()),
-                                            QuasarAppUtils::Error);
+int Packing::runCommands(const QList<SystemCommandData> &commands, const QString &workDir) {
 
+    auto allExecRight =  QFile::ExeUser | QFile::ExeGroup | QFile::ExeOwner;
+    for (const auto& cmd: commands) {
+        if (cmd.function) {
+            continue;
+        }
 
-                return false;
-            }
+        QFileInfo cmdInfo(cmd.command);
+        if (!cmdInfo.permission(allExecRight)) {
+            QFile::setPermissions(cmdInfo.absoluteFilePath(), cmdInfo.permissions() | allExecRight);
+        }
+    }
 
-            auto exit = QString("exit code = %0").arg(_proc->exitCode());
-            QString stdoutLog = _proc->readAllStandardOutput();
-            QString erroutLog = _proc->readAllStandardError();
-            auto message = QString("message = %0").arg(stdoutLog + " " + erroutLog);
+    QStringList errors;
+    QMutex errorsMutex;
+    QAtomicInt failed;
 
-            if (_proc->exitCode() != 0) {
-                QuasarAppUtils::Params::log(message, QuasarAppUtils::Error);
+    // the threads are shared between the running jobs, so the jobs with own workers (zip) do not create jobs * jobs threads.
+    const int jobs = Parallel::jobs();
+    const int activeJobs = std::max(1, std::min(jobs, static_cast<int>(commands.size())));
+    const int jobThreads = std::max(1, jobs / activeJobs);
 
-                if (QuasarAppUtils::Params::isDebug())
-                    return false;
-            }
+    Parallel::forEach(commands.size(), [&](int index) {
+        QString error;
+        if (!runCommand(commands[index], workDir, jobThreads, error)) {
+            failed.fetchAndAddRelaxed(1);
         }
 
-        if (!package->cb()) {
-            return false;
+        if (error.size()) {
+            QMutexLocker locker(&errorsMutex);
+            errors.push_back(error);
         }
+    }, jobs);
 
-        if (!restorePackagesLocations()) {
-            return false;
-        }
+    for (const auto &error: qAsConst(errors)) {
+        QuasarAppUtils::Params::log(error, QuasarAppUtils::Error);
+    }
 
-        package->removeTemplate();
-        delete package;
+    if (failed.loadAcquire()) {
+        QuasarAppUtils::Params::log(QString("%0 of %1 packing jobs failed").
+                                    arg(failed.loadAcquire()).
+                                    arg(commands.size()),
+                                    QuasarAppUtils::Error);
     }
 
-    const DeployConfig *cfg = DeployCore::_config;
-    return QDir(cfg->getTargetDir() + "/" + TMP_PACKAGE_DIR).removeRecursively();
+    return failed.loadAcquire();
 }
 
-bool Packing::movePackage(const QString &package,
+bool Packing::linkPackage(const QString &package,
                           const QString &newLocation) {
 
-    // Disable moving data for extracting defaults templates.
+    // Disable linking data for extracting defaults templates.
     if (QuasarAppUtils::Params::isEndable("getDefaultTemplate")) {
         return true;
     }
 
-    if (moveData(_packagesLocations.value(package),
-                 newLocation)) {
-
-        _packagesLocations[package] = newLocation;
+    const QString source = _packagesLocations.value(package);
+    if (source == newLocation) {
         return true;
     }
 
-    return false;
+    // the staged data is not moved, so the next distributions use same data without restoring.
+    if (!_fileManager->linkFolder(source, newLocation)) {
+        return false;
+    }
+
+    _packageViews.push_back(newLocation);
+    return true;
 }
 
 bool Packing::copyPackage(const QString &package, const QString &newLocation) {
@@ -188,7 +267,6 @@ bool Packing::collectPackages() {
         _packagesLocations.insert(it.key(), cfg->getTargetDir() + "/" + TMP_PACKAGE_DIR + "/" + it.key());
     }
 
-    _defaultPackagesLocations = _packagesLocations;
     return true;
 }
 
@@ -201,7 +279,6 @@ bool Packing::prepareTemplatesForExtract() {
                                   cfg->getTargetDir() + "/" + TMP_PACKAGE_DIR + "/" + it.key());
     }
 
-    _defaultPackagesLocations = _packagesLocations;
     return true;
 }
 
@@ -216,29 +293,17 @@ bool Packing::moveData(const QString &from, const QString &to, const QString &ig
     return QDir(from).removeRecursively();
 }
 
-bool Packing::restorePackagesLocations() {
-    for (auto it = _packagesLocations.begin(); it != _packagesLocations.end(); ++it) {
-        if (!moveData(it.value(), _defaultPackagesLocations.value(it.key()))) {
-            return false;
+bool Packing::removePackageViews() {
+    bool result = true;
+    for (const auto &view: qAsConst(_packageViews)) {
+        // the links are removed without following, so the staged data is not changed.
+        if (!QDir(view).removeRecursively()) {
+            QuasarAppUtils::Params::log("Failed to remove the package view " + view,
+                                        QuasarAppUtils::Error);
+            result = false;
         }
     }
-    _packagesLocations = _defaultPackagesLocations;
 
-    return true;
+    _packageViews.clear();
+    return result;
 }
-
-void Packing::handleOutputUpdate() {
-
-    QByteArray stdoutLog = _proc->readAllStandardOutput();
-    QByteArray erroutLog = _proc->readAllStandardError();
-
-    if (stdoutLog.size())
-        QuasarAppUtils::Params::log(stdoutLog,
-                                    QuasarAppUtils::Info);
-
-    if (erroutLog.size())
-        QuasarAppUtils::Params::log(erroutLog,
-                                    QuasarAppUtils::Info);
-}
-
-
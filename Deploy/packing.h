@@ -21,6 +21,7 @@
 class ConfigParser;
 class iDistribution;
 class FileManager;
+struct SystemCommandData;
 
 class DEPLOYSHARED_EXPORT Packing : public QObject, public PackageControl
 {
@@ -31,7 +32,7 @@ public:
     void setDistribution(const QList<iDistribution*> &pakages);
     bool create();
 
-    bool movePackage(const QString &package, const QString &newLocation) override;
+    bool linkPackage(const QString &package, const QString &newLocation) override;
     bool copyPackage(const QString &package, const QString &newLocation) override;
 
     /**
@@ -40,29 +41,41 @@ public:
      */
     bool extractTemplates();
 
+    /**
+     * @brief runCommands This method runs the commands of all distributions on the jobs worker threads.
+     *  Every command runs in own process and all errors are printed after finish of all commands.
+     *  The failed command does not stop other commands.
+     * @param commands This is list of commands.
+     * @param workDir This is working directory of the command processes.
+     * @return count of the failed commands.
+     */
+    static int runCommands(const QList<SystemCommandData> &commands, const QString &workDir);
+
 protected:
     QStringList availablePackages() const override;
 
 private:
 
     bool collectPackages();
+
     bool prepareTemplatesForExtract();
 
     bool moveData(const QString& from, const QString& to,
                   const QString &ignore = "") const;
 
-    bool restorePackagesLocations();
+    /**
+     * @brief removePackageViews This method removes views created by the linkPackage method for all distributions.
+     * @return true if all views removed.
+     */
+    bool removePackageViews();
 
     QList<iDistribution*> _pakages;
-    QProcess *_proc = nullptr;
     QHash<QString, QString> _packagesLocations;
-    QHash<QString, QString> _defaultPackagesLocations;
+    /// views of the packages created for the distributions.
+    QStringList _packageViews;
 
     FileManager* _fileManager = nullptr;
 
-private slots:
-    void handleOutputUpdate();
-
 };
 
 #endif // PACKING_H
@@ -0,0 +1,89 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "deployconfig.h"
+#include "deploycore.h"
+#include "parallel.h"
+
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief The Worker class takes indexes from the shared counter until all items will be processed.
+ */
+class Worker: public QRunnable {
+public:
+    Worker(QAtomicInt *index, int count, const std::function<void(int)> &func):
+        _index(index),
+        _count(count),
+        _func(func) {
+    }
+
+    void run() override {
+        int i;
+        while ((i = _index->fetchAndAddOrdered(1)) < _count) {
+            _func(i);
+        }
+    }
+
+private:
+    QAtomicInt *_index = nullptr;
+    int _count = 0;
+    const std::function<void(int)> &_func;
+};
+
+}
+
+int Parallel::jobs() {
+    if (DeployCore::_config && DeployCore::_config->jobs > 0) {
+        return DeployCore::_config->jobs;
+    }
+
+    return std::max(QThread::idealThreadCount(), 1);
+}
+
+int Parallel::ioJobs() {
+    if (DeployCore::_config && DeployCore::_config->ioJobs > 0) {
+        return DeployCore::_config->ioJobs;
+    }
+
+    return std::max(QThread::idealThreadCount(), 1);
+}
+
+void Parallel::forEach(int count, const std::function<void (int)> &func, int jobs) {
+    if (count <= 0) {
+        return;
+    }
+
+    if (jobs <= 1 || count == 1) {
+        for (int i = 0; i < count; ++i) {
+            func(i);
+        }
+
+        return;
+    }
+
+    int workers = std::min(jobs, count);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(workers);
+
+    QAtomicInt index(0);
+    for (int i = 0; i < workers; ++i) {
+        auto worker = new Worker(&index, count, func);
+        worker->setAutoDelete(true);
+        pool.start(worker);
+    }
+
+    pool.waitForDone();
+}
@@ -0,0 +1,45 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "deploy_global.h"
+#include <functional>
+
+/**
+ * @brief The Parallel class contains helpers for running independent jobs on a bounded pool of worker threads.
+ */
+class DEPLOYSHARED_EXPORT Parallel
+{
+public:
+    Parallel() = delete;
+
+    /**
+     * @brief jobs This method return count of worker threads selected by the jobs option.
+     * @return count of worker threads. By default it is count of cpu cores.
+     */
+    static int jobs();
+
+    /**
+     * @brief ioJobs This method return count of worker threads selected by the ioJobs option.
+     * @return count of worker threads for file operations. By default it is count of cpu cores.
+     */
+    static int ioJobs();
+
+    /**
+     * @brief forEach This method invoke the func for each index from 0 to count - 1.
+     *  The indexes are distributed between workers dynamically, so the order of invocations is not defined.
+     * @param count This is count of items.
+     * @param func This is job of one item. Must be thread-safe.
+     * @param jobs This is maximum count of worker threads. If this value less or equals 1 then all items will be processed in the current thread.
+     */
+    static void forEach(int count, const std::function<void(int index)>& func,
+                        int jobs = Parallel::jobs());
+};
+
+#endif // PARALLEL_H
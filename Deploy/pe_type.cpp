@@ -11,57 +11,238 @@
 #include <QFileInfo>
 #include <QSet>
 #include <QVector>
-#include <parser-library/parse.h>
+#include <QtEndian>
+#include <algorithm>
 #include <quasarapp.h>
 
-#include <set>
+namespace {
 
-namespace peparse {
-
-class section;
+enum : quint16 {
+    PE_MACHINE_I386  = 0x014c,
+    PE_MACHINE_ARM   = 0x01c0,
+    PE_MACHINE_ARMNT = 0x01c4,
+    PE_MACHINE_AMD64 = 0x8664,
+    PE_MACHINE_ARM64 = 0xaa64
+};
 
-struct importent {
-  VA addr;
-  std::string symbolName;
-  std::string moduleName;
+enum : quint16 {
+    NT_OPTIONAL_32_MAGIC = 0x010b,
+    NT_OPTIONAL_64_MAGIC = 0x020b
 };
 
-struct exportent {
-  VA addr;
-  std::string symbolName;
-  std::string moduleName;
+enum : int {
+    DIR_IMPORT       = 1,
+    DIR_DELAY_IMPORT = 13
 };
 
-class reloc;
-class symbol;
+/**
+ * @brief The PEImage class is read only view of the mapped pe file.
+ * This class decodes only the headers and the import directories of the file.
+ */
+class PEImage {
+public:
+    PEImage(const uchar *data, qint64 size):
+        _data(data), _size(size) {
+    }
 
-struct parsed_pe_internal {
-  std::vector<section> secs;
-  std::vector<resource> rsrcs;
-  std::vector<importent> imports;
-  std::vector<reloc> relocs;
-  std::vector<exportent> exports;
-  std::vector<symbol> symbols;
-};
+    bool init() {
+        if (!contains(0, 64) || _data[0] != 'M' || _data[1] != 'Z') {
+            return false;
+        }
 
-}
+        const quint32 ntHeader = read<quint32>(0x3c);
+        if (!contains(ntHeader, 24) || qstrncmp(reinterpret_cast<const char*>(_data + ntHeader), "PE\0\0", 4) != 0) {
+            return false;
+        }
+
+        const quint32 fileHeader = ntHeader + 4;
+        _machine = read<quint16>(fileHeader);
+        const quint16 sectionsCount = read<quint16>(fileHeader + 2);
+        const quint16 optionalSize = read<quint16>(fileHeader + 16);
+
+        const quint32 optional = fileHeader + 20;
+        _magic = read<quint16>(optional);
+
+        quint32 dirsCount = 0, dirs = 0;
+        if (_magic == NT_OPTIONAL_32_MAGIC) {
+            _imageBase = read<quint32>(optional + 28);
+            dirsCount = read<quint32>(optional + 92);
+            dirs = optional + 96;
+        } else if (_magic == NT_OPTIONAL_64_MAGIC) {
+            _imageBase = read<quint64>(optional + 24);
+            dirsCount = read<quint32>(optional + 108);
+            dirs = optional + 112;
+        } else {
+            return false;
+        }
+
+        for (int dir: {DIR_IMPORT, DIR_DELAY_IMPORT}) {
+            if (static_cast<quint32>(dir) < dirsCount &&
+                    dirs + dir * 8u + 8u <= optional + optionalSize) {
+                _dirs[dir] = read<quint32>(dirs + dir * 8u);
+            }
+        }
+
+        const quint32 sections = optional + optionalSize;
+        for (quint16 i = 0; i < sectionsCount; ++i) {
+            const quint32 header = sections + i * 40u;
+            if (!contains(header, 40)) {
+                return false;
+            }
+
+            Section section;
+            section.virtualSize = read<quint32>(header + 8);
+            section.virtualAddress = read<quint32>(header + 12);
+            section.rawSize = read<quint32>(header + 16);
+            section.rawPointer = read<quint32>(header + 20);
+            _sections.push_back(section);
+        }
+
+        return true;
+    }
+
+    quint16 machine() const {
+        return _machine;
+    }
 
-bool PE::getDep(peparse::parsed_pe_internal * internal, LibInfo &res) const {
-    auto imports = internal->imports;
-    std::set<std::string> filter;
+    quint16 magic() const {
+        return _magic;
+    }
+
+    /**
+     * @brief imports This method returns module names of the import and the delay import directories.
+     * @return list of unique module names in the upper case.
+     */
+    QStringList imports() const {
+        QStringList result;
+        QSet<QByteArray> filter;
+
+        auto add = [&result, &filter](const QByteArray& name) {
+            auto upper = name.toUpper();
+            if (upper.size() && !filter.contains(upper)) {
+                filter.insert(upper);
+                result.push_back(QString::fromLatin1(upper));
+            }
+        };
+
+        quint64 offset = 0;
+        if (_dirs[DIR_IMPORT] && rvaToOffset(_dirs[DIR_IMPORT], offset)) {
+            // IMAGE_IMPORT_DESCRIPTOR
+            for (; contains(offset, 20); offset += 20) {
+                const quint32 name = read<quint32>(offset + 12);
+                if (!name && !read<quint32>(offset + 16)) {
+                    break;
+                }
+
+                add(string(name));
+            }
+        }
 
-    for ( auto &i : imports) {
-        if (!filter.count(i.moduleName)) {
-            filter.insert(i.moduleName);
-            res.addDependncies(QString::fromStdString(i.moduleName));
+        if (_dirs[DIR_DELAY_IMPORT] && rvaToOffset(_dirs[DIR_DELAY_IMPORT], offset)) {
+            // IMAGE_DELAYLOAD_DESCRIPTOR
+            for (; contains(offset, 32); offset += 32) {
+                const quint32 attributes = read<quint32>(offset);
+                quint64 name = read<quint32>(offset + 4);
+                if (!name) {
+                    break;
+                }
+
+                // The old style descriptors contain virtual addresses instead of rva.
+                if (!(attributes & 1)) {
+                    if (name < _imageBase) {
+                        continue;
+                    }
+                    name -= _imageBase;
+                }
+
+                add(string(name));
+            }
         }
+
+        return result;
+    }
+
+private:
+    struct Section {
+        quint32 virtualSize = 0;
+        quint32 virtualAddress = 0;
+        quint32 rawSize = 0;
+        quint32 rawPointer = 0;
+    };
+
+    bool contains(quint64 offset, quint64 size) const {
+        return offset <= static_cast<quint64>(_size) &&
+                size <= static_cast<quint64>(_size) - offset;
     }
 
-    if (res.getWinApi() != WinAPI::NoWinAPI) {
-        res.addDependncies(_winAPI.value(res.getWinApi()));
+    template<typename T>
+    T read(quint64 offset) const {
+        if (!contains(offset, sizeof(T))) {
+            return 0;
+        }
+
+        return qFromLittleEndian<T>(_data + offset);
     }
 
-    return res.getDependncies().size() || !imports.size();
+    bool rvaToOffset(quint64 rva, quint64& offset) const {
+        for (const auto &section: _sections) {
+            const quint64 size = std::max(section.virtualSize, section.rawSize);
+            if (rva >= section.virtualAddress && rva - section.virtualAddress < size) {
+                if (rva - section.virtualAddress >= section.rawSize) {
+                    return false;
+                }
+
+                offset = section.rawPointer + (rva - section.virtualAddress);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    QByteArray string(quint64 rva) const {
+        quint64 offset = 0;
+        if (!rvaToOffset(rva, offset) || !contains(offset, 1)) {
+            return {};
+        }
+
+        auto begin = reinterpret_cast<const char*>(_data + offset);
+        return QByteArray(begin, static_cast<int>(qstrnlen(begin, static_cast<uint>(
+                                                               std::min<quint64>(_size - offset, 0xFFFF)))));
+    }
+
+    const uchar *_data = nullptr;
+    qint64 _size = 0;
+    quint16 _machine = 0;
+    quint16 _magic = 0;
+    quint64 _imageBase = 0;
+    quint32 _dirs[DIR_DELAY_IMPORT + 1] = {};
+    QVector<Section> _sections;
+};
+
+Platform platformOf(quint16 machine, quint16 magic) {
+    if (machine == PE_MACHINE_ARM ||
+        machine == PE_MACHINE_ARM64 ||
+        machine == PE_MACHINE_ARMNT) {
+
+        return (magic == NT_OPTIONAL_32_MAGIC)? Win_ARM_32: win_ARM_64;
+    }
+
+    if (machine == PE_MACHINE_I386 ||
+        machine == PE_MACHINE_AMD64) {
+
+        return (magic == NT_OPTIONAL_32_MAGIC)? Win32: Win64;
+    }
+
+    return UnknownPlatform;
+}
+
+}
+
+void PE::addWinAPIDependencies(LibInfo &info) const {
+    if (info.getWinApi() != WinAPI::NoWinAPI) {
+        info.addDependncies(_winAPI.value(info.getWinApi()));
+    }
 }
 
 QHash<WinAPI, QSet<QString> > PE::getWinAPI() const {
@@ -110,34 +291,24 @@ PE::PE(): IGetLibInfo () {
 }
 
 bool PE::getLibInfo(const QString &lib, LibInfo &info) const {
-    auto parsedPeLib = peparse::ParsePEFromFile(lib.toLatin1());
-
-    if (!parsedPeLib)
+    QFile file(lib);
+    if (!file.open(QIODevice::ReadOnly)) {
         return false;
+    }
 
-    if (parsedPeLib->peHeader.nt.FileHeader.Machine == peparse::IMAGE_FILE_MACHINE_ARM ||
-        parsedPeLib->peHeader.nt.FileHeader.Machine == peparse::IMAGE_FILE_MACHINE_ARM64 ||
-        parsedPeLib->peHeader.nt.FileHeader.Machine == peparse::IMAGE_FILE_MACHINE_ARMNT) {
-
-        if (parsedPeLib->peHeader.nt.OptionalMagic == peparse::NT_OPTIONAL_32_MAGIC) {
-            info.setPlatform(Win_ARM_32);
-
-        } else {
-            info.setPlatform(win_ARM_64);
-        }
-
-    } else if (parsedPeLib->peHeader.nt.FileHeader.Machine == peparse::IMAGE_FILE_MACHINE_I386 ||
-               parsedPeLib->peHeader.nt.FileHeader.Machine == peparse::IMAGE_FILE_MACHINE_AMD64) {
-
-        if (parsedPeLib->peHeader.nt.OptionalMagic == peparse::NT_OPTIONAL_32_MAGIC) {
-            info.setPlatform(Win32);
+    const qint64 fileSize = file.size();
+    const uchar* data = file.map(0, fileSize);
+    if (!data) {
+        return false;
+    }
 
-        } else {
-            info.setPlatform(Win64);
-        }
+    PEImage image(data, fileSize);
+    if (!image.init()) {
+        return false;
+    }
 
-    } else {
-        info.setPlatform(UnknownPlatform);
+    info.setPlatform(platformOf(image.machine(), image.magic()));
+    if (info.getPlatform() == UnknownPlatform) {
         return false;
     }
 
@@ -145,15 +316,42 @@ bool PE::getLibInfo(const QString &lib, LibInfo &info) const {
     info.setPath(QFileInfo(lib).absolutePath());
     info.setWinApi(getAPIModule(info.getName()));
 
-    if (!getDep(parsedPeLib->internal, info)) {
-        peparse::DestructParsedPE(parsedPeLib);
-        return false;
+    const auto imports = image.imports();
+    for (const auto &dep : imports) {
+        info.addDependncies(dep);
+    }
+
+    return info.isValid();
+}
+
+Platform PE::getPlatform(const QString &lib) const {
+    QFile file(lib);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return UnknownPlatform;
     }
 
-    peparse::DestructParsedPE(parsedPeLib);
+    const QByteArray header = file.read(512);
+    if (header.size() < 64 || !header.startsWith("MZ")) {
+        return UnknownPlatform;
+    }
 
+    // The signature, the file header and the magic of the optional header.
+    const int ntSize = 26;
+    const qint64 ntHeader = qFromLittleEndian<quint32>(header.constData() + 0x3c);
 
-    return info.isValid();
+    QByteArray nt;
+    if (ntHeader + ntSize <= header.size()) {
+        nt = header.mid(static_cast<int>(ntHeader), ntSize);
+    } else if (file.seek(ntHeader)) {
+        nt = file.read(ntSize);
+    }
+
+    if (nt.size() < ntSize || !nt.startsWith(QByteArray("PE\0\0", 4))) {
+        return UnknownPlatform;
+    }
+
+    return platformOf(qFromLittleEndian<quint16>(nt.constData() + 4),
+                      qFromLittleEndian<quint16>(nt.constData() + 24));
 }
 
 PE::~PE(){
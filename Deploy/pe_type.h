@@ -21,14 +21,10 @@
 #define API_MS_WIN_SECURITY "-security-"
 #define API_MS_WIN_BASE "-base-"
 
-namespace peparse {
-struct parsed_pe_internal;
-}
 class PE : public IGetLibInfo {
 
 private:
 
-    bool getDep(peparse::parsed_pe_internal *, LibInfo &res) const;
     QHash<WinAPI, QSet<QString>> _winAPI;
 
 public:
@@ -38,6 +34,20 @@ public:
 
     bool getLibInfo(const QString& lib, LibInfo& info) const override;
 
+    /**
+     * @brief getPlatform This method reads only the headers of the file.
+     * @param lib This is path to pe file.
+     * @return platform of the file or UnknownPlatform if the file is not valid pe file.
+     */
+    Platform getPlatform(const QString& lib) const;
+
+    /**
+     * @brief addWinAPIDependencies This method adds the dependencies of the api-ms-win libraries from the current environment.
+     * @note The getLibInfo method do not add these dependencies because they depend on the environment and not on the file.
+     * @param info This is information of the library.
+     */
+    void addWinAPIDependencies(LibInfo& info) const;
+
     ~PE() override;
 
     QHash<WinAPI, QSet<QString>> getWinAPI() const;
@@ -0,0 +1,515 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "uringcopier.h"
+
+#include <QFile>
+
+#if defined(Q_OS_LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define CQT_IO_URING
+#endif
+#endif
+
+#ifdef CQT_IO_URING
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// max size of the file copied by the one read and write operation.
+const qint64 MaxFileSize = 1024 * 1024;
+
+// max memory of the buffers of the one chunk of files.
+const qint64 MaxChunkMemory = 32 * 1024 * 1024;
+
+// max count of the files of the one chunk.
+const int MaxChunkFiles = 1024;
+
+struct File {
+    QByteArray from;
+    QByteArray to;
+    int src = -1;
+    int dst = -1;
+    int openError = 0;
+    int statError = 0;
+    struct statx info;
+    std::vector<char> buffer;
+    bool removeTarget = false;
+};
+
+}
+
+struct UringCopier::Ring {
+    int fd = -1;
+
+    void *sqPtr = MAP_FAILED;
+    size_t sqSize = 0;
+    void *cqPtr = MAP_FAILED;
+    size_t cqSize = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned *sqArray = nullptr;
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe *cqes = nullptr;
+
+    /// the operations of the broken ring can be still in progress, so the memory of them must not be freed.
+    bool busy = false;
+
+    bool init(unsigned entries);
+    void destroy();
+
+    /**
+     * @brief stage This method submits count of operations and waits for all completions.
+     *  If the ring is broken then this method waits for completions of the already submitted operations.
+     * @param count This is count of operations.
+     * @param prepare This is function that fills the operation with index.
+     * @param complete This is function that handles result of the operation with index.
+     * @return false if the ring is broken. If the submitted operations can not be waited then the busy flag is set.
+     */
+    template<typename Prepare, typename Complete>
+    bool stage(int count, Prepare prepare, Complete complete);
+};
+
+bool UringCopier::Ring::init(unsigned entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+        return false;
+    }
+
+    sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap) {
+        sqSize = cqSize = std::max(sqSize, cqSize);
+    }
+
+    sqPtr = mmap(nullptr, sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                 fd, IORING_OFF_SQ_RING);
+    if (sqPtr == MAP_FAILED) {
+        return false;
+    }
+
+    if (singleMap) {
+        cqPtr = sqPtr;
+    } else {
+        cqPtr = mmap(nullptr, cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     fd, IORING_OFF_CQ_RING);
+        if (cqPtr == MAP_FAILED) {
+            return false;
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+
+    auto sq = static_cast<char*>(sqPtr);
+    sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqEntries = params.sq_entries;
+    sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    auto cq = static_cast<char*>(cqPtr);
+    cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    return true;
+}
+
+void UringCopier::Ring::destroy() {
+    if (sqes != MAP_FAILED) {
+        munmap(sqes, sqesSize);
+    }
+
+    if (cqPtr != MAP_FAILED && cqPtr != sqPtr) {
+        munmap(cqPtr, cqSize);
+    }
+
+    if (sqPtr != MAP_FAILED) {
+        munmap(sqPtr, sqSize);
+    }
+
+    if (fd >= 0) {
+        ::close(fd);
+    }
+
+    fd = -1;
+    sqPtr = cqPtr = MAP_FAILED;
+    sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+}
+
+template<typename Prepare, typename Complete>
+bool UringCopier::Ring::stage(int count, Prepare prepare, Complete complete) {
+    int index = 0;
+    while (index < count) {
+        const unsigned slice = std::min(static_cast<unsigned>(count - index), sqEntries);
+
+        unsigned tail = *sqTail;
+        for (unsigned i = 0; i < slice; ++i) {
+            const unsigned slot = tail & sqMask;
+            io_uring_sqe *sqe = &sqes[slot];
+            memset(sqe, 0, sizeof(*sqe));
+            prepare(sqe, index + static_cast<int>(i));
+            sqe->user_data = static_cast<__u64>(index) + i;
+            sqArray[slot] = slot;
+            ++tail;
+        }
+        __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+        unsigned toSubmit = slice;
+        unsigned completed = 0;
+        bool broken = false;
+
+        // the operations consumed by the kernel use the buffers of the caller,
+        // so all of them are waited even if the next operations can not be submitted.
+        while (completed < slice - toSubmit || (!broken && completed < slice)) {
+            int submitted = static_cast<int>(syscall(__NR_io_uring_enter, fd, (broken)? 0 : toSubmit, 1,
+                                                     IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (submitted < 0) {
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                    if (broken) {
+                        busy = true;
+                        return false;
+                    }
+
+                    broken = true;
+                }
+            } else if (!broken) {
+                toSubmit -= static_cast<unsigned>(submitted);
+            }
+
+            unsigned head = *cqHead;
+            const unsigned cqTailValue = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+            while (head != cqTailValue) {
+                const io_uring_cqe &cqe = cqes[head & cqMask];
+                complete(static_cast<int>(cqe.user_data), cqe.res);
+                ++head;
+                ++completed;
+            }
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        }
+
+        if (broken) {
+            return false;
+        }
+
+        index += static_cast<int>(slice);
+    }
+
+    return true;
+}
+
+UringCopier::UringCopier(unsigned int entries) {
+    _ring = new Ring();
+    if (!_ring->init(entries)) {
+        _ring->destroy();
+        delete _ring;
+        _ring = nullptr;
+    }
+}
+
+UringCopier::~UringCopier() {
+    if (_ring) {
+        _ring->destroy();
+        delete _ring;
+    }
+}
+
+bool UringCopier::isSupported() {
+    static const bool supported = []() {
+        UringCopier copier(4);
+        if (!copier.isValid()) {
+            return false;
+        }
+
+        const int opsCount = 256;
+        std::vector<char> memory(sizeof(io_uring_probe) + opsCount * sizeof(io_uring_probe_op), 0);
+        auto probe = reinterpret_cast<io_uring_probe*>(memory.data());
+
+        if (syscall(__NR_io_uring_register, copier._ring->fd, IORING_REGISTER_PROBE, probe, opsCount) < 0) {
+            return false;
+        }
+
+        for (int op : {IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_CLOSE}) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+                return false;
+            }
+        }
+
+        return true;
+    }();
+
+    return supported;
+}
+
+qint64 UringCopier::maxFileSize() {
+    return MaxFileSize;
+}
+
+bool UringCopier::isValid() const {
+    return _ring;
+}
+
+void UringCopier::copy(QVector<Task> &tasks) {
+    if (!isValid()) {
+        return;
+    }
+
+    mode_t umaskValue = umask(0);
+    umask(umaskValue);
+
+    int begin = 0;
+    while (begin < tasks.size()) {
+        const int end = std::min(begin + MaxChunkFiles, tasks.size());
+        std::vector<File> files(static_cast<size_t>(end - begin));
+
+        for (int i = begin; i < end; ++i) {
+            files[i - begin].from = QFile::encodeName(tasks[i].from);
+            files[i - begin].to = QFile::encodeName(tasks[i].to);
+            tasks[i].status = NotHandled;
+        }
+
+        const int count = static_cast<int>(files.size());
+        bool ok = true;
+
+        // stage 1: open the sources and read the metadata.
+        ok = ok && _ring->stage(count * 2, [&files](io_uring_sqe* sqe, int i) {
+            File &file = files[static_cast<size_t>(i / 2)];
+            sqe->fd = AT_FDCWD;
+            sqe->addr = reinterpret_cast<__u64>(file.from.constData());
+            if (i % 2 == 0) {
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->open_flags = O_RDONLY | O_CLOEXEC;
+            } else {
+                sqe->opcode = IORING_OP_STATX;
+                sqe->len = STATX_TYPE | STATX_MODE | STATX_SIZE;
+                sqe->off = reinterpret_cast<__u64>(&file.info);
+            }
+        }, [&files](int i, int res) {
+            File &file = files[static_cast<size_t>(i / 2)];
+            if (i % 2 == 0) {
+                file.src = (res >= 0)? res : -1;
+                file.openError = (res < 0)? -res : 0;
+            } else {
+                file.statError = (res < 0)? -res : 0;
+            }
+        });
+
+        // select small regular files, other files should be copied by another method.
+        std::vector<int> selected;
+        qint64 memory = 0;
+        for (int i = 0; i < count; ++i) {
+            File &file = files[static_cast<size_t>(i)];
+            if (file.src < 0 || file.statError || !S_ISREG(file.info.stx_mode) ||
+                    static_cast<qint64>(file.info.stx_size) > MaxFileSize ||
+                    memory + static_cast<qint64>(file.info.stx_size) > MaxChunkMemory) {
+                continue;
+            }
+
+            memory += static_cast<qint64>(file.info.stx_size);
+            selected.push_back(i);
+        }
+
+        // stage 2: create the targets.
+        ok = ok && _ring->stage(static_cast<int>(selected.size()), [&](io_uring_sqe* sqe, int i) {
+            File &file = files[static_cast<size_t>(selected[static_cast<size_t>(i)])];
+            sqe->opcode = IORING_OP_OPENAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = reinterpret_cast<__u64>(file.to.constData());
+            sqe->open_flags = O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC;
+            sqe->len = file.info.stx_mode & 07777;
+        }, [&](int i, int res) {
+            const int fileIndex = selected[static_cast<size_t>(i)];
+            File &file = files[static_cast<size_t>(fileIndex)];
+            if (res >= 0) {
+                file.dst = res;
+                file.removeTarget = true;
+                return;
+            }
+
+            if (-res == EEXIST) {
+                tasks[begin + fileIndex].status = Failed;
+                tasks[begin + fileIndex].error = "Destination file exists";
+            }
+        });
+
+        std::vector<int> data;
+        for (int i : selected) {
+            File &file = files[static_cast<size_t>(i)];
+            if (file.dst < 0) {
+                continue;
+            }
+
+            if (file.info.stx_size) {
+                file.buffer.resize(file.info.stx_size);
+                data.push_back(i);
+            } else {
+                tasks[begin + i].status = Done;
+            }
+        }
+
+        // stage 3: read the sources.
+        ok = ok && _ring->stage(static_cast<int>(data.size()), [&](io_uring_sqe* sqe, int i) {
+            File &file = files[static_cast<size_t>(data[static_cast<size_t>(i)])];
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = file.src;
+            sqe->addr = reinterpret_cast<__u64>(file.buffer.data());
+            sqe->len = static_cast<__u32>(file.buffer.size());
+            sqe->off = 0;
+        }, [&](int i, int res) {
+            File &file = files[static_cast<size_t>(data[static_cast<size_t>(i)])];
+            if (res < 0 || static_cast<size_t>(res) != file.buffer.size()) {
+                // the file is changed or can not be read, so copy it with another method.
+                file.buffer.clear();
+            }
+        });
+
+        // stage 4: write the targets.
+        ok = ok && _ring->stage(static_cast<int>(data.size()), [&](io_uring_sqe* sqe, int i) {
+            File &file = files[static_cast<size_t>(data[static_cast<size_t>(i)])];
+            sqe->opcode = IORING_OP_WRITE;
+            sqe->fd = file.dst;
+            sqe->addr = reinterpret_cast<__u64>(file.buffer.data());
+            // the empty buffer is skipped with the zero length write.
+            sqe->len = static_cast<__u32>(file.buffer.size());
+            sqe->off = 0;
+        }, [&](int i, int res) {
+            const int fileIndex = data[static_cast<size_t>(i)];
+            File &file = files[static_cast<size_t>(fileIndex)];
+            if (file.buffer.size() && res >= 0 && static_cast<size_t>(res) == file.buffer.size()) {
+                tasks[begin + fileIndex].status = Done;
+            }
+        });
+
+        // the mode of created file is changed by umask, so fix it for the copied files.
+        for (int i : selected) {
+            File &file = files[static_cast<size_t>(i)];
+            if (file.dst >= 0 && tasks[begin + i].status == Done &&
+                    (file.info.stx_mode & 07777 & umaskValue) &&
+                    fchmod(file.dst, file.info.stx_mode & 07777) != 0) {
+                tasks[begin + i].status = NotHandled;
+            }
+        }
+
+        // stage 5: close all descriptors.
+        std::vector<int> descriptors;
+        std::vector<int> owners;
+        for (int i = 0; i < count; ++i) {
+            const File &file = files[static_cast<size_t>(i)];
+            if (file.src >= 0) {
+                descriptors.push_back(file.src);
+                owners.push_back(-1);
+            }
+
+            if (file.dst >= 0) {
+                descriptors.push_back(file.dst);
+                owners.push_back(i);
+            }
+        }
+
+        bool closed = ok && _ring->stage(static_cast<int>(descriptors.size()), [&](io_uring_sqe* sqe, int i) {
+            sqe->opcode = IORING_OP_CLOSE;
+            sqe->fd = descriptors[static_cast<size_t>(i)];
+        }, [&](int i, int res) {
+            const int owner = owners[static_cast<size_t>(i)];
+            if (res < 0 && owner >= 0) {
+                tasks[begin + owner].status = NotHandled;
+            }
+        });
+
+        if (!closed) {
+            // the ring is broken, all next files will be copied by another method.
+            for (int descriptor: descriptors) {
+                ::close(descriptor);
+            }
+
+            if (_ring->busy) {
+                // the kernel can still write to the buffers and the metadata of the files, so they are leaked instead of freeing.
+                new std::vector<File>(std::move(files));
+            }
+
+            _ring->destroy();
+            delete _ring;
+            _ring = nullptr;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            Task &task = tasks[begin + i];
+            File &file = files[static_cast<size_t>(i)];
+
+            if (task.status == Done) {
+                task.size = static_cast<qint64>(file.info.stx_size);
+            } else if (file.removeTarget) {
+                ::unlink(file.to.constData());
+            }
+        }
+
+        if (!_ring) {
+            return;
+        }
+
+        begin = end;
+    }
+}
+
+#else
+
+struct UringCopier::Ring {
+};
+
+UringCopier::UringCopier(unsigned int entries) {
+    Q_UNUSED(entries)
+}
+
+UringCopier::~UringCopier() {
+}
+
+bool UringCopier::isSupported() {
+    return false;
+}
+
+qint64 UringCopier::maxFileSize() {
+    return 0;
+}
+
+bool UringCopier::isValid() const {
+    return false;
+}
+
+void UringCopier::copy(QVector<Task> &tasks) {
+    Q_UNUSED(tasks)
+}
+
+#endif
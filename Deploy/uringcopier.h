@@ -0,0 +1,83 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef URINGCOPIER_H
+#define URINGCOPIER_H
+
+#include "deploy_global.h"
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The UringCopier class copies the batches of the small files with the io_uring interface of the linux kernel.
+ * All files of the batch are processed by stages (openat and statx, openat of targets, read, write, close),
+ * every stage is submitted to the kernel with the one system call.
+ * The files that can not be copied with io_uring (large files, not regular files, unsupported errors) are marked as NotHandled,
+ * so the caller should copy them with another method.
+ * This class is available only on linux, on other platforms the isSupported method returns false.
+ */
+class DEPLOYSHARED_EXPORT UringCopier
+{
+public:
+    enum Status {
+        /// the file is copied.
+        Done,
+        /// the file should be copied with another method.
+        NotHandled,
+        /// the file can not be copied (for example the target file already exists).
+        Failed
+    };
+
+    struct Task {
+        QString from;
+        QString to;
+        Status status = NotHandled;
+        /// count of copied bytes.
+        qint64 size = 0;
+        QString error;
+    };
+
+    /**
+     * @brief UringCopier This constructor creates new ring.
+     * @param entries This is size of the submission queue.
+     */
+    explicit UringCopier(unsigned int entries = 256);
+    ~UringCopier();
+
+    UringCopier(const UringCopier&) = delete;
+    UringCopier& operator=(const UringCopier&) = delete;
+
+    /**
+     * @brief isSupported This method checks that the kernel supports all operations used by this class.
+     *  The check is invoked once.
+     * @return true if io_uring can be used.
+     */
+    static bool isSupported();
+
+    /**
+     * @brief maxFileSize This method returns maximum size of the file that copied with io_uring.
+     */
+    static qint64 maxFileSize();
+
+    /**
+     * @brief isValid This method returns true if the ring is created.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief copy This method copies files of the tasks with the permissions. The target files must not exist.
+     * @param tasks This is list of the files. The status of the every task will be updated.
+     */
+    void copy(QVector<Task>& tasks);
+
+private:
+    struct Ring;
+    Ring *_ring = nullptr;
+};
+
+#endif // URINGCOPIER_H
@@ -8,13 +8,14 @@
 #include "zipcompresser.h"
 
 #include <QDir>
+#include "parallel.h"
 #include "zip.h"
 
 ZipCompresser::ZipCompresser() {
 
 }
 
-bool ZipCompresser::compress(const QString &path, const QString &distArrhive) const {
+bool ZipCompresser::compress(const QString &path, const QString &distArrhive, int level, int jobs) const {
 
     QFileInfo arrInfo(distArrhive);
     QFileInfo srcInfo(path);
@@ -32,22 +33,8 @@ bool ZipCompresser::compress(const QString &path, const QString &distArrhive) co
     }
 
 
-    auto stdstr = arrInfo.absoluteFilePath().toStdString();
-    const char *zipArr = stdstr.c_str();
-
-    struct zip_t *zip = zip_open(zipArr, ZIP_DEFAULT_COMPRESSION_LEVEL, 'w');
-
-    if (!add(srcInfo.absoluteFilePath(), "", zip)) {
-
-        zip_close(zip);
-        QFile::remove(arrInfo.absoluteFilePath());
-
-        return false;
-    }
-
-    zip_close(zip);
-
-    return true;
+    ZipWriter writer(level, (jobs > 0)? jobs: Parallel::jobs());
+    return writer.write(srcInfo.absoluteFilePath(), arrInfo.absoluteFilePath());
 }
 
 int on_extract_entry(const char *filename, void *) {
@@ -64,41 +51,3 @@ bool ZipCompresser::extract(const QString &arrhive, const QString &distDir) cons
                        stdstr_dir.c_str(),
                        on_extract_entry, nullptr) == 0;
 }
-
-bool ZipCompresser::add(const QString& root, const QString& path, zip_t * zip) const {
-    QFileInfo info(root + "/" + path);
-
-    if (info.isFile()) {
-        std::string _file_tmp = path.toStdString();
-
-        const char *file = _file_tmp.c_str();
-
-        if (zip_entry_open(zip, file) != 0) {
-            return false;
-        }
-
-        QFile src(info.absoluteFilePath());
-        if (!src.open(QIODevice::ReadOnly)) {
-            return false;
-        }
-        auto data = src.readAll();
-        if (zip_entry_write(zip, data.data(), data.size()) != 0) {
-            return false;
-        }
-
-        src.close();
-
-        return zip_entry_close(zip) == 0;
-    }
-
-    QDir dir(info.absoluteFilePath());
-
-    auto list = dir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot);
-    for (const auto& entry: list) {
-        if (!add(root, (path.size())? path + "/" + entry: entry, zip)) {
-            return false;
-        }
-    }
-
-    return true;
-}
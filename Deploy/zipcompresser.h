@@ -10,8 +10,7 @@
 
 #include <QString>
 #include <deploy_global.h>
-
-class zip_t;
+#include "zipwriter.h"
 
 /**
  * @brief The ZipCompresser class - this is cpp wraper for use zip C library
@@ -22,12 +21,15 @@ public:
     ZipCompresser();
 
     /**
-     * @brief compress - create a new zip arrhive from folder
+     * @brief compress - create a new zip arrhive from folder. The files are compressed on the jobs worker threads (see the ZipWriter class).
      * @param path - path to folder for commpressing
      * @param distArrhive - path to arrhive
+     * @param level - compression level from 0 to 9
+     * @param jobs - count of the compression threads. If this value is 0 then used the jobs option.
      * @return true if new arrhive created successsful
      */
-    bool compress(const QString& path, const QString& distArrhive) const;
+    bool compress(const QString& path, const QString& distArrhive,
+                  int level = ZipWriter::DefaultLevel, int jobs = 0) const;
 
     /**
      * @brief extract - extract all files from zip arhive
@@ -37,16 +39,6 @@ public:
      */
     bool extract(const QString& arrhive, const QString& distDir) const;
 
-
-private:
-    /**
-     * @brief add - recursive add files in to zip
-     * @param root - root path of arrhived dir
-     * @param path - path to file
-     * @param zip
-     * @return
-     */
-    bool add(const QString &root, const QString &path, zip_t *zip) const;
 };
 
 #endif // ZIPCOMPRESSER_H
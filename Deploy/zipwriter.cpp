@@ -0,0 +1,403 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "zipwriter.h"
+#include "parallel.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QSaveFile>
+#include <QtEndian>
+#include <algorithm>
+#include <memory>
+#include <quasarapp.h>
+
+// only declarations, the implementation of the miniz is compiled in the miniz.c file.
+#define MINIZ_HEADER_FILE_ONLY
+#include "miniz.h"
+
+namespace {
+
+const quint32 LocalHeaderSignature = 0x04034b50;
+const quint32 CentralHeaderSignature = 0x02014b50;
+const quint32 Zip64EndSignature = 0x06064b50;
+const quint32 Zip64LocatorSignature = 0x07064b50;
+const quint32 EndSignature = 0x06054b50;
+
+const int LocalHeaderSize = 30;
+const int Zip64ExtraId = 0x0001;
+
+const quint16 VersionDefault = 20;
+const quint16 VersionZip64 = 45;
+/// the external attributes contain the unix permissions.
+const quint16 HostUnix = 3 << 8;
+/// names of the entries are encoded in UTF-8.
+const quint16 FlagUtf8 = 1 << 11;
+const quint16 MethodDeflate = 8;
+
+const quint32 Max32 = 0xFFFFFFFFu;
+const quint16 Max16 = 0xFFFFu;
+
+// the deflate stream can be slightly bigger than the source, so the big files use ZIP64 with reserve.
+const qint64 Zip64Threshold = 0xF0000000ll;
+
+template <typename T>
+void put(QByteArray &out, T value) {
+    char data[sizeof(T)];
+    qToLittleEndian(value, data);
+    out.append(data, sizeof(T));
+}
+
+mz_bool appendOutput(const void *data, int size, void *user) {
+    static_cast<QByteArray*>(user)->append(static_cast<const char*>(data), size);
+    return MZ_TRUE;
+}
+
+// multiplication of the 32x32 matrix over GF(2) by the vector (see zlib crc32_combine).
+quint32 gf2MatrixTimes(const quint32 *matrix, quint32 vector) {
+    quint32 sum = 0;
+    while (vector) {
+        if (vector & 1) {
+            sum ^= *matrix;
+        }
+        vector >>= 1;
+        matrix++;
+    }
+
+    return sum;
+}
+
+void gf2MatrixSquare(quint32 *square, const quint32 *matrix) {
+    for (int n = 0; n < 32; n++) {
+        square[n] = gf2MatrixTimes(matrix, matrix[n]);
+    }
+}
+
+}
+
+const int ZipWriter::DefaultLevel;
+const qint64 ZipWriter::ChunkSize;
+
+ZipWriter::ZipWriter(int level, int jobs) {
+    _level = std::max(0, std::min(level, 9));
+    _jobs = std::max(jobs, 1);
+}
+
+quint32 ZipWriter::crc32Combine(quint32 first, quint32 second, qint64 secondSize) {
+    if (secondSize <= 0) {
+        return first;
+    }
+
+    quint32 even[32];
+    quint32 odd[32];
+
+    // operator for one zero bit.
+    odd[0] = 0xEDB88320u;
+    quint32 row = 1;
+    for (int n = 1; n < 32; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+
+    // operators for two and four zero bits.
+    gf2MatrixSquare(even, odd);
+    gf2MatrixSquare(odd, even);
+
+    // apply secondSize zero bytes to the first crc.
+    do {
+        gf2MatrixSquare(even, odd);
+        if (secondSize & 1) {
+            first = gf2MatrixTimes(even, first);
+        }
+        secondSize >>= 1;
+
+        if (!secondSize) {
+            break;
+        }
+
+        gf2MatrixSquare(odd, even);
+        if (secondSize & 1) {
+            first = gf2MatrixTimes(odd, first);
+        }
+        secondSize >>= 1;
+    } while (secondSize);
+
+    return first ^ second;
+}
+
+bool ZipWriter::write(const QString &folder, const QString &arhive) const {
+    const QDir root(folder);
+    if (!root.exists()) {
+        return false;
+    }
+
+    QVector<Entry> entries;
+    QDirIterator it(root.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo info = it.fileInfo();
+
+        Entry entry;
+        entry.name = root.relativeFilePath(info.absoluteFilePath()).toUtf8();
+        entry.file = info.absoluteFilePath();
+        entry.size = info.size();
+        entry.zip64 = entry.size >= Zip64Threshold;
+
+        QDateTime time = info.lastModified();
+        if (time.date().year() < 1980) {
+            time = QDateTime(QDate(1980, 1, 1), QTime(0, 0));
+        }
+        entry.dosTime = static_cast<quint16>((time.time().hour() << 11) |
+                                             (time.time().minute() << 5) |
+                                             (time.time().second() / 2));
+        entry.dosDate = static_cast<quint16>(((time.date().year() - 1980) << 9) |
+                                             (time.date().month() << 5) |
+                                             time.date().day());
+
+        const auto permissions = static_cast<quint32>(info.permissions());
+        entry.mode = 0100000 |
+                (((permissions >> 12) & 7) << 6) |
+                (((permissions >> 4) & 7) << 3) |
+                (permissions & 7);
+
+        entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &left, const Entry &right) {
+        return left.name < right.name;
+    });
+
+    QVector<Chunk> chunks;
+    for (int i = 0; i < entries.size(); ++i) {
+        qint64 offset = 0;
+        do {
+            Chunk chunk;
+            chunk.entry = i;
+            chunk.offset = offset;
+            chunk.size = std::min(ChunkSize, entries[i].size - offset);
+            offset += chunk.size;
+            chunk.last = offset >= entries[i].size;
+            chunks.push_back(chunk);
+        } while (offset < entries[i].size);
+    }
+
+    QSaveFile out(arhive);
+    if (!out.open(QIODevice::WriteOnly)) {
+        QuasarAppUtils::Params::log("Failed to create " + arhive + ": " + out.errorString(),
+                                    QuasarAppUtils::Error);
+        return false;
+    }
+
+    // only some chunks are kept in memory, so the memory usage does not depend on size of the files.
+    const int window = _jobs * 4;
+    for (int begin = 0; begin < chunks.size(); begin += window) {
+        const int count = std::min(window, chunks.size() - begin);
+
+        // the workers use raw pointers because the non-const access to the QVector is not thread-safe.
+        Chunk *windowChunks = chunks.data() + begin;
+        const Entry *entriesData = entries.constData();
+        Parallel::forEach(count, [this, windowChunks, entriesData](int index) {
+            Chunk &chunk = windowChunks[index];
+            compressChunk(entriesData[chunk.entry], chunk);
+        }, _jobs);
+
+        for (int i = begin; i < begin + count; ++i) {
+            Chunk &chunk = chunks[i];
+            Entry &entry = entries[chunk.entry];
+
+            if (!chunk.done) {
+                QuasarAppUtils::Params::log("Failed to compress " + entry.file,
+                                            QuasarAppUtils::Error);
+                out.cancelWriting();
+                return false;
+            }
+
+            if (chunk.offset == 0) {
+                entry.headerOffset = out.pos();
+                if (!writeLocalHeader(out, entry)) {
+                    out.cancelWriting();
+                    return false;
+                }
+            }
+
+            if (out.write(chunk.data) != chunk.data.size()) {
+                out.cancelWriting();
+                return false;
+            }
+
+            entry.crc = (chunk.offset == 0)? chunk.crc: crc32Combine(entry.crc, chunk.crc, chunk.size);
+            entry.compressedSize += chunk.data.size();
+            chunk.data = QByteArray();
+
+            if (chunk.last) {
+                if (!entry.zip64 && entry.compressedSize >= Max32) {
+                    QuasarAppUtils::Params::log("The compressed size of " + entry.file + " is too big",
+                                                QuasarAppUtils::Error);
+                    out.cancelWriting();
+                    return false;
+                }
+
+                // the crc and the compressed size are known only after compressing, so the local header is updated.
+                const qint64 end = out.pos();
+                if (!out.seek(entry.headerOffset) || !writeLocalHeader(out, entry) || !out.seek(end)) {
+                    out.cancelWriting();
+                    return false;
+                }
+            }
+        }
+    }
+
+    if (!writeCentralDirectory(out, entries)) {
+        out.cancelWriting();
+        return false;
+    }
+
+    return out.commit();
+}
+
+void ZipWriter::compressChunk(const Entry &entry, Chunk &chunk) const {
+    QFile file(entry.file);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(chunk.offset)) {
+        return;
+    }
+
+    QByteArray data = file.read(chunk.size);
+    if (data.size() != chunk.size) {
+        return;
+    }
+
+    const auto *bytes = reinterpret_cast<const unsigned char*>(data.constData());
+    chunk.crc = static_cast<quint32>(mz_crc32(MZ_CRC32_INIT, bytes, static_cast<size_t>(data.size())));
+
+    // the compressor is too big for the stack.
+    std::unique_ptr<tdefl_compressor> compressor(new tdefl_compressor);
+    const int flags = static_cast<int>(tdefl_create_comp_flags_from_zip_params(_level, -MZ_DEFAULT_WINDOW_BITS,
+                                                                               MZ_DEFAULT_STRATEGY));
+    if (tdefl_init(compressor.get(), appendOutput, &chunk.data, flags) != TDEFL_STATUS_OKAY) {
+        return;
+    }
+
+    // the full flush aligns the end of the chunk to the byte, so the next chunk can be appended to the same deflate stream.
+    auto status = tdefl_compress_buffer(compressor.get(), bytes, static_cast<size_t>(data.size()),
+                                        (chunk.last)? TDEFL_FINISH: TDEFL_FULL_FLUSH);
+
+    chunk.done = (chunk.last)? status == TDEFL_STATUS_DONE: status == TDEFL_STATUS_OKAY;
+}
+
+bool ZipWriter::writeLocalHeader(QFileDevice &out, const Entry &entry) const {
+    QByteArray header;
+    header.reserve(LocalHeaderSize + entry.name.size() + 20);
+
+    put<quint32>(header, LocalHeaderSignature);
+    put<quint16>(header, (entry.zip64)? VersionZip64: VersionDefault);
+    put<quint16>(header, FlagUtf8);
+    put<quint16>(header, MethodDeflate);
+    put<quint16>(header, entry.dosTime);
+    put<quint16>(header, entry.dosDate);
+    put<quint32>(header, entry.crc);
+    put<quint32>(header, (entry.zip64)? Max32: static_cast<quint32>(entry.compressedSize));
+    put<quint32>(header, (entry.zip64)? Max32: static_cast<quint32>(entry.size));
+    put<quint16>(header, static_cast<quint16>(entry.name.size()));
+    put<quint16>(header, (entry.zip64)? 20: 0);
+    header.append(entry.name);
+
+    if (entry.zip64) {
+        put<quint16>(header, Zip64ExtraId);
+        put<quint16>(header, 16);
+        put<quint64>(header, static_cast<quint64>(entry.size));
+        put<quint64>(header, static_cast<quint64>(entry.compressedSize));
+    }
+
+    return out.write(header) == header.size();
+}
+
+bool ZipWriter::writeCentralDirectory(QFileDevice &out, const QVector<Entry> &entries) const {
+    const qint64 directoryOffset = out.pos();
+
+    QByteArray directory;
+    for (const auto &entry: entries) {
+        const bool offset64 = entry.headerOffset >= Max32;
+
+        QByteArray extra;
+        if (entry.zip64) {
+            put<quint64>(extra, static_cast<quint64>(entry.size));
+            put<quint64>(extra, static_cast<quint64>(entry.compressedSize));
+        }
+
+        if (offset64) {
+            put<quint64>(extra, static_cast<quint64>(entry.headerOffset));
+        }
+
+        if (extra.size()) {
+            QByteArray field;
+            put<quint16>(field, Zip64ExtraId);
+            put<quint16>(field, static_cast<quint16>(extra.size()));
+            extra.prepend(field);
+        }
+
+        const quint16 version = (entry.zip64 || offset64)? VersionZip64: VersionDefault;
+
+        put<quint32>(directory, CentralHeaderSignature);
+        put<quint16>(directory, HostUnix | version);
+        put<quint16>(directory, version);
+        put<quint16>(directory, FlagUtf8);
+        put<quint16>(directory, MethodDeflate);
+        put<quint16>(directory, entry.dosTime);
+        put<quint16>(directory, entry.dosDate);
+        put<quint32>(directory, entry.crc);
+        put<quint32>(directory, (entry.zip64)? Max32: static_cast<quint32>(entry.compressedSize));
+        put<quint32>(directory, (entry.zip64)? Max32: static_cast<quint32>(entry.size));
+        put<quint16>(directory, static_cast<quint16>(entry.name.size()));
+        put<quint16>(directory, static_cast<quint16>(extra.size()));
+        put<quint16>(directory, 0);
+        put<quint16>(directory, 0);
+        put<quint16>(directory, 0);
+        put<quint32>(directory, entry.mode << 16);
+        put<quint32>(directory, (offset64)? Max32: static_cast<quint32>(entry.headerOffset));
+        directory.append(entry.name);
+        directory.append(extra);
+    }
+
+    const qint64 directorySize = directory.size();
+    const bool zip64 = entries.size() >= Max16 || directoryOffset >= Max32 || directorySize >= Max32;
+
+    if (zip64) {
+        const qint64 zip64EndOffset = directoryOffset + directorySize;
+
+        put<quint32>(directory, Zip64EndSignature);
+        // size of the record without the signature and this field.
+        put<quint64>(directory, 44);
+        put<quint16>(directory, HostUnix | VersionZip64);
+        put<quint16>(directory, VersionZip64);
+        put<quint32>(directory, 0);
+        put<quint32>(directory, 0);
+        put<quint64>(directory, static_cast<quint64>(entries.size()));
+        put<quint64>(directory, static_cast<quint64>(entries.size()));
+        put<quint64>(directory, static_cast<quint64>(directorySize));
+        put<quint64>(directory, static_cast<quint64>(directoryOffset));
+
+        put<quint32>(directory, Zip64LocatorSignature);
+        put<quint32>(directory, 0);
+        put<quint64>(directory, static_cast<quint64>(zip64EndOffset));
+        put<quint32>(directory, 1);
+    }
+
+    const quint16 count = (entries.size() >= Max16)? Max16: static_cast<quint16>(entries.size());
+
+    put<quint32>(directory, EndSignature);
+    put<quint16>(directory, 0);
+    put<quint16>(directory, 0);
+    put<quint16>(directory, count);
+    put<quint16>(directory, count);
+    put<quint32>(directory, (directorySize >= Max32)? Max32: static_cast<quint32>(directorySize));
+    put<quint32>(directory, (directoryOffset >= Max32)? Max32: static_cast<quint32>(directoryOffset));
+    put<quint16>(directory, 0);
+
+    return out.write(directory) == directory.size();
+}
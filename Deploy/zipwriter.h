@@ -0,0 +1,101 @@
+//#
+//# Copyright (C) 2018-2021 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef ZIPWRITER_H
+#define ZIPWRITER_H
+
+#include "deploy_global.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+class QFileDevice;
+
+/**
+ * @brief The ZipWriter class creates the zip arhive from the folder and compresses the files on the worker threads.
+ * Every file is splited to the chunks (see the ChunkSize), every chunk is compressed by the separate deflate compressor
+ * (with the full flush at the end of the chunk), so the compressed chunks are concatenated into the one deflate stream of the entry.
+ * The crc32 of the entry is combined from the crc32 of the chunks.
+ * The entries are written in sorted order of the paths, so the same folder is always compressed into the same arhive.
+ * The ZIP64 records are written for big files and big arhives.
+ */
+class DEPLOYSHARED_EXPORT ZipWriter
+{
+public:
+    /// default compression level (same as the default level of the zip library).
+    static const int DefaultLevel = 6;
+
+    /// size of the part of the file compressed by one job.
+    static const qint64 ChunkSize = 1024 * 1024;
+
+    /**
+     * @brief ZipWriter
+     * @param level This is compression level from 0 (no compression) to 9 (best compression).
+     * @param jobs This is count of worker threads.
+     */
+    ZipWriter(int level = DefaultLevel, int jobs = 1);
+
+    /**
+     * @brief write This method creates new arhive from all files of the folder. The arhive is replaced atomically.
+     * @param folder This is path to compressed folder.
+     * @param arhive This is path to arhive.
+     * @return true if arhive created successful.
+     */
+    bool write(const QString &folder, const QString &arhive) const;
+
+    /**
+     * @brief crc32Combine This method calculates crc32 of the concatenated data from the crc32 of the parts.
+     * @param first This is crc32 of the first part.
+     * @param second This is crc32 of the second part.
+     * @param secondSize This is size of the second part.
+     * @return crc32 of the whole data (same as zlib crc32_combine).
+     */
+    static quint32 crc32Combine(quint32 first, quint32 second, qint64 secondSize);
+
+private:
+    struct Entry {
+        /// UTF-8 path inside arhive.
+        QByteArray name;
+        QString file;
+        qint64 size = 0;
+        quint16 dosTime = 0;
+        quint16 dosDate = 0;
+        quint32 mode = 0;
+
+        quint32 crc = 0;
+        qint64 compressedSize = 0;
+        qint64 headerOffset = 0;
+        bool zip64 = false;
+    };
+
+    struct Chunk {
+        int entry = 0;
+        qint64 offset = 0;
+        qint64 size = 0;
+        bool last = false;
+
+        QByteArray data;
+        quint32 crc = 0;
+        bool done = false;
+    };
+
+    /**
+     * @brief compressChunk This method reads and compresses the chunk of the entry.
+     * @param entry This is entry of the chunk.
+     * @param chunk This is chunk. The data, crc and done fields will be updated.
+     */
+    void compressChunk(const Entry &entry, Chunk &chunk) const;
+
+    bool writeLocalHeader(QFileDevice &out, const Entry &entry) const;
+    bool writeCentralDirectory(QFileDevice &out, const QVector<Entry> &entries) const;
+
+    int _level = DefaultLevel;
+    int _jobs = 1;
+};
+
+#endif // ZIPWRITER_H
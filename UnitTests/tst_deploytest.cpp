@@ -18,8 +18,23 @@
 #include <pathutils.h>
 #include <dependencymap.h>
 #include <packing.h>
+#include <Distributions/idistribution.h>
 #include <pluginsparser.h>
 #include <zipcompresser.h>
+#include <parallel.h>
+#include <libinfocache.h>
+#include <libgraph.h>
+#include <ldcache.h>
+#include <ahocorasick.h>
+#include <ignorerule.h>
+#include <libpriorityclassifier.h>
+#include <copybackend.h>
+#include <filemanager.h>
+#include <uringcopier.h>
+#include <deploymanifest.h>
+#include <elf_type.h>
+#include <pe_type.h>
+#include <zipwriter.h>
 #include <QStorageInfo>
 
 #include <QMap>
@@ -37,6 +52,21 @@
 static const QString TestBinDir = TEST_BIN_DIR;
 static const QString TestQtDir = QT_BASE_DIR;
 
+/**
+ * @brief The ConfigGuard struct restores the global deploy config at the end of the scope (even if the test is failed).
+ */
+struct ConfigGuard {
+    ConfigGuard(const DeployConfig *config) {
+        DeployCore::_config = config;
+    }
+
+    ~ConfigGuard() {
+        DeployCore::_config = saved;
+    }
+
+    const DeployConfig *saved = DeployCore::_config;
+};
+
 class deploytest : public QObject
 {
     Q_OBJECT
@@ -94,6 +124,8 @@ private slots:
     // tested flags customScript
 
     void testZip();
+    void testZipLargeEntry();
+    void testZipWriter();
     void costomScript();
     void testDistroStruct();
 
@@ -159,12 +191,56 @@ private slots:
 
     // qif and zip flags
     void testMultiPacking();
+    void testPackingCommands();
 
     // init flags
     void testInit();
 
     void testDependencyMap();
 
+    void testParallel();
+    void testParallelScan();
+
+    void testLibInfoCache();
+
+    void testLibGraph();
+
+    void testLdCache();
+
+    void testIgnoreRule();
+
+    void testLibPriorityClassifier();
+
+    void testQtModulesMatcher_data();
+    void testQtModulesMatcher();
+
+    void testCopyBackend();
+
+    void testParallelCopy();
+
+    void testUringCopier();
+
+    void testCopyModesBenchmark_data();
+    void testCopyModesBenchmark();
+
+    void testIncrementalDeploy();
+
+    void testDeployManifest();
+
+    void testParallelClear();
+
+    void testStripDeployedFiles();
+
+    void testElfReader();
+    void testPEReader();
+
+    void testElfStrip();
+
+    void testSplitDebug();
+
+    void testMoveFolder();
+    void testLinkFolder();
+
     void testQmlScaner();
 
     void testPrefix();
@@ -912,6 +988,1609 @@ void deploytest::testDependencyMap() {
 
 }
 
+void deploytest::testParallel() {
+    const int count = 1000;
+
+    for (int jobs : {1, 2, 8}) {
+        QVector<QAtomicInt> visits(count);
+        QAtomicInt *data = visits.data();
+
+        Parallel::forEach(count, [data](int index) {
+            data[index].fetchAndAddOrdered(1);
+        }, jobs);
+
+        for (const auto &visit : qAsConst(visits)) {
+            QVERIFY(visit.loadAcquire() == 1);
+        }
+    }
+}
+
+void deploytest::testParallelScan() {
+    QuasarAppUtils::Params::parseParams(QStringList{"noScanCache"});
+
+    // the test binary depends on the Qt and the system libraries.
+    const QStringList targets = {QCoreApplication::applicationFilePath()};
+    QStringList env = {
+        QCoreApplication::applicationDirPath(),
+        QLibraryInfo::location(QLibraryInfo::LibrariesPath),
+        QLibraryInfo::location(QLibraryInfo::BinariesPath),
+    };
+
+#ifdef Q_OS_LINUX
+    LdCache cache;
+    if (cache.load()) {
+        env += cache.dirs();
+    }
+#endif
+
+    QSet<QString> expected;
+    for (int jobs : {1, 2, 8}) {
+        DeployConfig config;
+        config.jobs = jobs;
+        ConfigGuard guard(&config);
+
+        DependenciesScanner scaner;
+        scaner.setEnvironment(env);
+        scaner.preScan(targets);
+
+        QSet<QString> result;
+        for (const auto &target: targets) {
+            const auto view = scaner.scan(target);
+            for (const auto &lib: view) {
+                result += lib.fullPath() + ":" + QString::number(lib.getPriority());
+            }
+        }
+
+        if (jobs == 1) {
+            QVERIFY(result.size());
+            expected = result;
+        }
+
+        QVERIFY2(result == expected, QString("jobs: %0").arg(jobs).toLatin1());
+    }
+
+    QuasarAppUtils::Params::parseParams(QStringList{});
+}
+
+void deploytest::testLibInfoCache() {
+    const QString lib = "./test/cache/lib.so";
+    const QString cacheFile = "./test/cache/libinfo.cache";
+
+    QDir().mkpath("./test/cache");
+    QFile f(lib);
+    QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    f.write("lib", 3);
+    f.close();
+
+    LibInfo info;
+    info.setPlatform(Unix64);
+    info.setName("lib.so");
+    info.setDependncies({"LIBC.SO.6"});
+
+    LibInfoCache cache;
+    cache.setLocation(cacheFile);
+    cache.insert(lib, info);
+    QVERIFY(cache.save());
+
+    LibInfoCache loaded;
+    loaded.setLocation(cacheFile);
+    QVERIFY(loaded.load());
+    QVERIFY(loaded.size() == 1);
+
+    LibInfo result;
+    QVERIFY(loaded.find(lib, result));
+    QVERIFY(result.getPlatform() == Unix64);
+    QVERIFY(result.getName() == "lib.so");
+    QVERIFY(result.getDependncies() == info.getDependncies());
+
+    // changed file must be parsed again
+    QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    f.write("changed lib", 11);
+    f.close();
+    QVERIFY(!loaded.find(lib, result));
+
+    QVERIFY(loaded.purge());
+    QVERIFY(!QFile::exists(cacheFile));
+    QVERIFY(loaded.size() == 0);
+
+    // the records that are not used by the run are removed while saving.
+    const QString other = "./test/cache/other.so";
+    QFile otherFile(other);
+    QVERIFY(otherFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    otherFile.write("other", 5);
+    otherFile.close();
+
+    LibInfoCache full;
+    full.setLocation(cacheFile);
+    full.insert(lib, info);
+    full.insert(other, info);
+    QVERIFY(full.save());
+
+    LibInfoCache used;
+    used.setLocation(cacheFile);
+    QVERIFY(used.load());
+    QVERIFY(used.size() == 2);
+    QVERIFY(used.find(lib, result));
+    QVERIFY(used.save());
+    QVERIFY(used.size() == 1);
+
+    LibInfoCache evicted;
+    evicted.setLocation(cacheFile);
+    QVERIFY(evicted.load());
+    QVERIFY(evicted.size() == 1);
+    QVERIFY(!evicted.find(other, result));
+
+    // the records of the removed files are removed too.
+    QVERIFY(QFile::remove(lib));
+    QVERIFY(!evicted.find(lib, result));
+    evicted.insert(other, info);
+    QVERIFY(evicted.save());
+
+    QVERIFY(loaded.load());
+    QVERIFY(loaded.size() == 1);
+    QVERIFY(loaded.find(other, result));
+
+    QDir("./test/cache").removeRecursively();
+}
+
+void deploytest::testLibGraph() {
+    LibGraph graph;
+
+    auto makeLib = [](const QString& name) {
+        LibInfo info;
+        info.setPlatform(Unix_x86_64);
+        info.setName(name);
+        info.setPath("/test/lib");
+        return info;
+    };
+
+    auto a = graph.insert(makeLib("a.so"));
+    auto b = graph.insert(makeLib("b.so"));
+    auto c = graph.insert(makeLib("c.so"));
+    auto d = graph.insert(makeLib("d.so"));
+
+    QVERIFY(graph.size() == 4);
+    QVERIFY(graph.insert(makeLib("b.so")) == b);
+    QVERIFY(graph.find("/test/lib/c.so") == c);
+    QVERIFY(graph.find("/test/lib/e.so") == LibGraph::InvalidNode);
+
+    // a -> b -> c -> b, d without dependencies
+    graph.setEdges(a, {b});
+    graph.setEdges(b, {c});
+    graph.setEdges(c, {b});
+    graph.setEdges(d, {});
+
+    QVERIFY(graph.isResolved(a));
+    QVERIFY(graph.edges(a).size() == 1);
+    QVERIFY(graph.edges(d).size() == 0);
+
+    LibGraphView view(&graph, graph.closure(a));
+    QVERIFY(view.size() == 2);
+    QVERIFY(view.contains("/test/lib/b.so"));
+    QVERIFY(view.contains("/test/lib/c.so"));
+    QVERIFY(!view.contains("/test/lib/a.so"));
+
+    for (const auto &lib: view) {
+        QVERIFY(lib.getName() == "b.so" || lib.getName() == "c.so");
+    }
+
+    // the nodes of cycle depend on itself
+    QVERIFY(graph.closure(b).testBit(static_cast<int>(b)));
+    QVERIFY(graph.closure(c).testBit(static_cast<int>(c)));
+    QVERIFY(!graph.closure(a).testBit(static_cast<int>(a)));
+    QVERIFY(graph.closure(d).count(true) == 0);
+
+    // the new nodes do not change closures of the old nodes
+    auto e = graph.insert(makeLib("e.so"));
+    graph.setEdges(e, {a, d});
+    QVERIFY(graph.closure(e).count(true) == 3);
+    QVERIFY(graph.closure(a).count(true) == 2);
+
+    graph.clear();
+    QVERIFY(graph.size() == 0);
+
+    // the root "s.so" depends on the library with the same name (the wrapper), and the root "b.so" depends on the "s.so".
+    // the closures do not depend on order of the roots.
+    auto resolveRoots = [&makeLib](bool wrapperFirst) {
+        LibGraph graph;
+        auto s = graph.insert(makeLib("s.so"));
+        auto b = graph.insert(makeLib("b.so"));
+
+        auto wrapperInfo = makeLib("s.so");
+        wrapperInfo.setPath("/test/wrapper");
+        auto wrapper = graph.insert(wrapperInfo);
+        auto x = graph.insert(makeLib("x.so"));
+
+        QVector<LibGraph::NodeId> roots = {s, b};
+        if (!wrapperFirst) {
+            std::reverse(roots.begin(), roots.end());
+        }
+
+        // the scanner resolves all nodes that are reachable from the root (the resolved nodes are ignored).
+        for (auto root : qAsConst(roots)) {
+            if (root == s) {
+                graph.setEdges(s, {}, {wrapper});
+            } else {
+                graph.setEdges(b, {wrapper});
+            }
+
+            graph.setEdges(wrapper, {x});
+            graph.setEdges(x, {});
+
+            graph.closure(root);
+        }
+
+        QVERIFY(graph.isResolved(wrapper));
+        QVERIFY(graph.closure(s).count(true) == 1);
+        QVERIFY(graph.closure(s).testBit(static_cast<int>(wrapper)));
+        QVERIFY(graph.closure(b).count(true) == 2);
+        QVERIFY(graph.closure(b).testBit(static_cast<int>(x)));
+    };
+
+    resolveRoots(true);
+    resolveRoots(false);
+}
+
+void deploytest::testLdCache() {
+#ifdef Q_OS_LINUX
+    LdCache cache;
+
+    QVERIFY(!cache.load("./not_exists_ld.so.cache"));
+    QVERIFY(!cache.isLoaded());
+
+    if (!QFileInfo::exists(LdCache::defaultLocation())) {
+        QSKIP("The system has no ld.so.cache");
+    }
+
+    QVERIFY(cache.load());
+    QVERIFY(cache.isLoaded());
+    QVERIFY(cache.size());
+    QVERIFY(cache.dirs().size());
+    QVERIFY(cache.contains("libc.so.6"));
+
+    auto libc = cache.find("libc.so.6");
+    QVERIFY(QFileInfo(libc).exists());
+    QVERIFY(cache.dirs().contains(QFileInfo(libc).path()));
+
+    QVERIFY(!cache.contains("libNotExistsLib.so.1"));
+    QVERIFY(cache.find("libNotExistsLib.so.1").isEmpty());
+
+    // the library that is not exists in the environment is resolved by the cache of the dynamic linker.
+    QuasarAppUtils::Params::parseParams(QStringList{"deploySystem", "noScanCache"});
+
+    DeployConfig config;
+    config.ldCache = cache;
+    ConfigGuard guard(&config);
+
+    DependenciesScanner scaner;
+    scaner.setEnvironment({});
+
+    const Platform platform = scaner.getPlatform(libc);
+    QVERIFY(platform & Platform::Unix);
+    QVERIFY(!cache.find("libc.so.6", platform).isEmpty());
+
+    LibInfo info;
+    QVERIFY(scaner.getLibFromEnvirement("libc.so.6", platform, info));
+    QVERIFY(QFileInfo(info.fullPath()).canonicalFilePath() ==
+            QFileInfo(cache.find("libc.so.6", platform)).canonicalFilePath());
+
+    QVERIFY(!scaner.getLibFromEnvirement("libNotExistsLib.so.1", platform, info));
+
+    QuasarAppUtils::Params::parseParams(QStringList{});
+#endif
+}
+
+void deploytest::testIgnoreRule() {
+    AhoCorasick matcher;
+    matcher.addPattern("he", 0);
+    matcher.addPattern("she", 1);
+    matcher.addPattern("hers", 2);
+    matcher.addPattern("his", 3);
+    matcher.build();
+
+    QVERIFY(matcher.matches("ushers") == QVector<int>({0, 1, 2}));
+    QVERIFY(matcher.firstMatch("this") == 3);
+    QVERIFY(matcher.firstMatch("abc") == -1);
+
+    IgnoreRule rules;
+    IgnoreData winRule("libc");
+    winRule.platform = Win;
+    rules.addRule(winRule);
+    rules.addRule(IgnoreData("libc"));
+    rules.addRule(IgnoreData("libcrypt"));
+
+    LibInfo info;
+    info.setPlatform(Unix_x86_64);
+    info.setName("libcrypt.so.1");
+    info.setPath("/test/lib");
+
+    // the first suitable rule in order of adding
+    auto rule = rules.isIgnore(info);
+    QVERIFY(rule);
+    QVERIFY(rule->label == "libc");
+    QVERIFY(rule->platform == UnknownPlatform);
+
+    // cached result
+    QVERIFY(rules.isIgnore(info) == rule);
+
+    info.setName("libQt5Core.so.5");
+    QVERIFY(!rules.isIgnore(info));
+}
+
+// legacy implementation of the priority of library, used as reference for the classifier.
+static LibPriority legacyLibPriority(const QString &lib) {
+    if (!QFileInfo(lib).isFile()) {
+        return NotFile;
+    }
+
+    if (DeployCore::isQtLib(lib)) {
+        return QtLib;
+    }
+
+    if (DeployCore::isExtraLib(lib)) {
+        return ExtraLib;
+    }
+
+    if (DeployCore::isAlienLib(lib)) {
+        return AlienLib;
+    }
+
+    if (DeployCore::isAllowedLib(lib)) {
+        return AllowedLib;
+    }
+
+    return SystemLib;
+}
+
+void deploytest::testLibPriorityClassifier() {
+    const QString qtLib = "./test/priority/libQt5Test.so.5";
+    const QString otherLib = "./test/priority/libOther.so.1";
+
+    QDir().mkpath("./test/priority");
+    for (const auto &lib: {qtLib, otherLib}) {
+        QFile f(lib);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write("lib", 3);
+        f.close();
+    }
+
+    LibPriorityClassifier classifier;
+    classifier.compile(nullptr);
+
+    QVERIFY(classifier.priority(qtLib) == QtLib);
+    QVERIFY(classifier.priority(otherLib) == SystemLib);
+    QVERIFY(classifier.priority("./test/priority/notExists.so") == NotFile);
+
+    // results are memoized until the next compilation.
+    QVERIFY(QFile::remove(otherLib));
+    QVERIFY(classifier.priority(otherLib) == SystemLib);
+
+    classifier.compile(nullptr);
+    QVERIFY(classifier.priority(otherLib) == NotFile);
+
+    // the classifier with the real configuration returns same priorities as the legacy implementation.
+    const QString root = QFileInfo("./test/priority").absoluteFilePath();
+    const QHash<QString, LibPriority> libs = {
+        {root + "/qt/lib/libQt5Core.so.5", QtLib},
+        {root + "/qt/plugins/platforms/libqxcb.so", SystemLib},
+        {root + "/system/libQt5Fake.so.5", SystemLib},
+        {root + "/system/libOther.so.1", SystemLib},
+        {root + "/system/libNamedExtra.so.1", ExtraLib},
+        {root + "/extra/libExtra.so.1", ExtraLib},
+        {root + "/extra/libQt5Extra.so.5", ExtraLib},
+        {root + "/extraMask/sub/libMasked.so.1", ExtraLib},
+        {root + "/opt/libAlien.so.1", AlienLib},
+        {root + "/opt/allowed/libAllowed.so.1", AlienLib},
+        {root + "/allowed/libAllowed.so.1", AllowedLib},
+        {root + "/system/libAllowedName.so.1", AllowedLib},
+        {root + "/system/notExists.so.1", NotFile},
+    };
+
+    for (auto it = libs.cbegin(); it != libs.cend(); ++it) {
+        if (it.value() == NotFile) {
+            continue;
+        }
+
+        QVERIFY(QDir().mkpath(QFileInfo(it.key()).absolutePath()));
+        QFile f(it.key());
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write("lib", 3);
+        f.close();
+    }
+
+    DeployConfig config;
+    config.qtDir.setLibs(root + "/qt/lib");
+    config.qtDir.setPlugins(root + "/qt/plugins");
+    config.extraPaths.addExtraPaths({root + "/extra"});
+    config.extraPaths.addExtraPathsMasks({"/extraMask/"});
+    config.extraPaths.addtExtraNamesMasks({"NamedExtra"});
+    config.allowedPaths.addExtraPaths({root + "/allowed", root + "/opt/allowed"});
+    config.allowedPaths.addtExtraNamesMasks({"AllowedName"});
+    ConfigGuard guard(&config);
+
+    classifier.compile(&config);
+
+    for (auto it = libs.cbegin(); it != libs.cend(); ++it) {
+        QVERIFY2(classifier.priority(it.key()) == legacyLibPriority(it.key()), qPrintable(it.key()));
+
+        // all libraries are alien if the tests are run from the /opt directory.
+        QVERIFY2(classifier.priority(it.key()) == it.value() || DeployCore::isAlienLib(root), qPrintable(it.key()));
+    }
+
+    QDir(root).removeRecursively();
+}
+
+// legacy implementation of the getQtModule method, used as reference for the compiled matcher.
+static DeployCore::QtModule legacyQtModule(const QString& lib) {
+    if (!DeployCore::isQtLib(lib)) {
+        return DeployCore::QtModule::NONE;
+    }
+
+    for (int i = 0; i < DeployCore::qtModuleEntriesCount(); ++i) {
+        if (DeployCore::containsModule(DeployCore::qtModuleEntries[i].libraryName, lib)) {
+            return static_cast<DeployCore::QtModule>(DeployCore::qtModuleEntries[i].module);
+        }
+    }
+
+    return DeployCore::QtModule::NONE;
+}
+
+void deploytest::testQtModulesMatcher_data() {
+    QTest::addColumn<bool>("legacy");
+
+    QTest::newRow("regexp") << true;
+    QTest::newRow("matcher") << false;
+}
+
+void deploytest::testQtModulesMatcher() {
+    QFETCH(bool, legacy);
+
+    QStringList libs;
+    for (const auto& version: {"4", "5", "6"}) {
+        for (const auto& module: {"Core", "Gui", "Widgets", "Network", "Qml", "Quick", "QuickControls2",
+                                  "QuickTemplates2", "Multimedia", "MultimediaWidgets", "MultimediaQuick",
+                                  "WebEngine", "WebEngineCore", "WebEngineWidgets", "Sql", "Svg", "Xml",
+                                  "XcbQpa", "DBus", "OpenGL", "PrintSupport", "Test", "Unknown"}) {
+            libs.push_back(QString("libQt%0%1.so.%0").arg(version, module));
+            libs.push_back(QString("Qt%0%1.dll").arg(version, module));
+        }
+    }
+
+    ConfigGuard guard(nullptr);
+
+    for (const auto& lib: qAsConst(libs)) {
+        QVERIFY2(legacyQtModule(lib) == DeployCore::getQtModule(lib), lib.toLatin1());
+    }
+
+    QVERIFY(DeployCore::getQtModule("libQt5Core.so.5") == DeployCore::QtCoreModule);
+    QVERIFY(DeployCore::getQtModule("libQt5MultimediaWidgets.so.5") == DeployCore::QtMultimediaModule);
+    QVERIFY(DeployCore::getQtModule("libQt5Unknown.so.5") == DeployCore::NONE);
+    QVERIFY(DeployCore::getQtModule("libOther.so.5") == DeployCore::NONE);
+
+    QSet<QString> translationLibs = {"libQt5Core.so.5", "libQt5Multimedia.so.5", "libQt5Help.so.5"};
+    QSet<QString> translations = {"qtbase", "qtmultimedia", "qt_help"};
+    const auto extracted = DeployCore::extractTranslation(translationLibs);
+    QVERIFY(extracted.size() == translations.size());
+    for (const auto& translation: extracted) {
+        QVERIFY(translations.contains(translation));
+    }
+
+    qint64 result = 0;
+    QBENCHMARK {
+        for (const auto& lib: qAsConst(libs)) {
+            result += legacy? legacyQtModule(lib) : DeployCore::getQtModule(lib);
+        }
+    }
+    QVERIFY(result);
+}
+
+void deploytest::testCopyBackend() {
+    const QString root = "./test/copyBackend";
+    const QString source = root + "/source.bin";
+    QDir(root).removeRecursively();
+    QDir().mkpath(root);
+
+    QByteArray data;
+    for (int i = 0; i < 1024 * 1024; ++i) {
+        data.push_back(static_cast<char>(i * 7));
+    }
+
+    QFile f(source);
+    QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QVERIFY(f.write(data) == data.size());
+    f.close();
+    auto permissions = QFile::permissions(source) | QFile::ExeOwner | QFile::ExeUser;
+    QVERIFY(QFile::setPermissions(source, permissions));
+
+    CopyBackend::Backend mode;
+    QVERIFY(CopyBackend::fromString("range", mode) && mode == CopyBackend::CopyFileRange);
+    QVERIFY(CopyBackend::fromString("qt", mode) && mode == CopyBackend::QtCopy);
+    QVERIFY(CopyBackend::fromString("auto", mode));
+    QVERIFY(!CopyBackend::fromString("fast", mode));
+
+    CopyBackend backend;
+    for (int i = 0; i < CopyBackend::BackendsCount; ++i) {
+        const QString target = root + "/target" + QString::number(i);
+        backend.setFirstBackend(static_cast<CopyBackend::Backend>(i));
+
+        QString error;
+        QVERIFY2(backend.copy(source, target, &error), error.toLatin1());
+
+        QFile copied(target);
+        QVERIFY(copied.open(QIODevice::ReadOnly));
+        QVERIFY(copied.readAll() == data);
+        QVERIFY(copied.permissions() == permissions);
+        copied.close();
+
+        // same as QFile::copy the existing target should not be overwritten.
+        QVERIFY(!backend.copy(source, target, &error));
+    }
+
+    qint64 bytes = 0;
+    int files = 0;
+    for (int i = 0; i < CopyBackend::BackendsCount; ++i) {
+        bytes += backend.bytes(static_cast<CopyBackend::Backend>(i));
+        files += backend.files(static_cast<CopyBackend::Backend>(i));
+    }
+
+    QVERIFY(files == CopyBackend::BackendsCount);
+    QVERIFY(bytes == data.size() * CopyBackend::BackendsCount);
+    QVERIFY(backend.files(CopyBackend::QtCopy) >= 1);
+
+    backend.resetStatistic();
+    QVERIFY(!backend.files(CopyBackend::QtCopy));
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testParallelCopy() {
+    const QString root = "./test/parallelCopy";
+    const QString source = root + "/source";
+    const QString target = root + "/target";
+    QDir(root).removeRecursively();
+
+    QStringList files;
+    for (int dir = 0; dir < 10; ++dir) {
+        const QString path = source + "/dir" + QString::number(dir) + "/sub";
+        QVERIFY(QDir().mkpath(path));
+
+        for (int i = 0; i < 50; ++i) {
+            const QString file = path + "/file" + QString::number(i) + ".qml";
+            QFile f(file);
+            QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            f.write(file.toLatin1());
+            f.close();
+            files.push_back(QFileInfo(file).absoluteFilePath());
+        }
+    }
+
+    FileManager manager;
+    QStringList copied;
+    QStringList mask = {"file1"};
+    QVERIFY(manager.copyFolder(source, target, {"file49"}, &copied, &mask));
+
+    // one file is ignored by the filter in the each directory.
+    QVERIFY(copied.size() == 10 * 49);
+    for (const auto &file: qAsConst(copied)) {
+        QVERIFY(file.startsWith(target));
+        QVERIFY(!file.contains("file49"));
+
+        bool exists = QFileInfo::exists(file);
+        QVERIFY(exists == QFileInfo(file).fileName().startsWith("file1"));
+    }
+
+    auto deployed = manager.getDeployedFiles();
+    QVERIFY(deployed.contains(QFileInfo(target + "/dir0/sub/file1.qml").absoluteFilePath()));
+    QVERIFY(!deployed.contains(QFileInfo(target + "/dir0/sub/file3.qml").absoluteFilePath()));
+
+    // the same target file from the different sources: the last source wins same as in sequential copying.
+    QStringList sameNames = {files[1], files[51], files[101]};
+    QVERIFY(manager.copyFileList(sameNames, target + "/flat"));
+
+    QFile flat(target + "/flat/file1.qml");
+    QFile last(files[101]);
+    QVERIFY(flat.open(QIODevice::ReadOnly));
+    QVERIFY(last.open(QIODevice::ReadOnly));
+    QVERIFY(flat.readAll() == last.readAll());
+    flat.close();
+    last.close();
+
+    QVERIFY(manager.copyFileList(files, target + "/all"));
+    QVERIFY(QDir(target + "/all").entryList(QDir::Files).size() == 50);
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testUringCopier() {
+    if (!UringCopier::isSupported()) {
+        QSKIP("io_uring is not supported");
+    }
+
+    const QString root = "./test/uringCopier";
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root + "/source"));
+    QVERIFY(QDir().mkpath(root + "/target"));
+
+    QVector<UringCopier::Task> tasks;
+    for (int i = 0; i < 600; ++i) {
+        UringCopier::Task task;
+        task.from = root + "/source/file" + QString::number(i);
+        task.to = root + "/target/file" + QString::number(i);
+
+        QFile f(task.from);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write(QByteArray((i * 31) % 4096, static_cast<char>('a' + i % 26)));
+        f.close();
+
+        tasks.push_back(task);
+    }
+
+    // the large file should be copied by another method.
+    UringCopier::Task large;
+    large.from = root + "/source/large";
+    large.to = root + "/target/large";
+    QFile f(large.from);
+    QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    f.write(QByteArray(UringCopier::maxFileSize() + 1, 'l'));
+    f.close();
+    tasks.push_back(large);
+
+    // the existing target should not be overwritten.
+    UringCopier::Task exists = tasks.first();
+    exists.to = root + "/target/exists";
+    QFile e(exists.to);
+    QVERIFY(e.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    e.close();
+    tasks.push_back(exists);
+
+    UringCopier copier(16);
+    QVERIFY(copier.isValid());
+    copier.copy(tasks);
+
+    for (int i = 0; i < 600; ++i) {
+        QVERIFY(tasks[i].status == UringCopier::Done);
+
+        QFile source(tasks[i].from);
+        QFile target(tasks[i].to);
+        QVERIFY(source.open(QIODevice::ReadOnly) && target.open(QIODevice::ReadOnly));
+        QVERIFY(source.readAll() == target.readAll());
+        QVERIFY(tasks[i].size == source.size());
+    }
+
+    QVERIFY(tasks[600].status == UringCopier::NotHandled);
+    QVERIFY(!QFile::exists(large.to));
+    QVERIFY(tasks[601].status == UringCopier::Failed);
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testCopyModesBenchmark_data() {
+    QTest::addColumn<QString>("mode");
+    QTest::addColumn<int>("ioJobs");
+
+    QTest::newRow("QFile::copy") << "qt" << 1;
+    QTest::newRow("thread pool") << "auto" << 0;
+    QTest::newRow("io_uring") << "uring" << 0;
+}
+
+void deploytest::testCopyModesBenchmark() {
+    QFETCH(QString, mode);
+    QFETCH(int, ioJobs);
+
+    if (mode == "uring" && !UringCopier::isSupported()) {
+        QSKIP("The io_uring is not supported by the kernel");
+    }
+
+    const QString root = "./test/copyModes";
+    const QString source = root + "/source";
+    QDir(root).removeRecursively();
+
+    // the generated tree looks like the qml modules: 20k small files in 200 directories.
+    const int filesCount = 20000;
+    const QByteArray data(512, 'q');
+    for (int i = 0; i < filesCount; ++i) {
+        const QString dir = source + "/module" + QString::number(i % 200);
+        if (i < 200) {
+            QVERIFY(QDir().mkpath(dir));
+        }
+
+        QFile f(dir + "/file" + QString::number(i) + ".qml");
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write(data);
+        f.close();
+    }
+
+    DeployConfig config;
+    config.ioJobs = ioJobs;
+    ConfigGuard guard(&config);
+
+    FileManager manager;
+    CopyBackend::Backend backend;
+    QVERIFY(CopyBackend::fromString(mode, backend));
+    manager.copyBackend().setFirstBackend(backend);
+
+    // every iteration copies into the new folder, so the removing of the previous result is not measured.
+    QStringList copied;
+    QString target;
+    int iteration = 0;
+    QBENCHMARK {
+        copied.clear();
+        target = root + "/target" + QString::number(iteration++);
+        manager.copyFolder(source, target, {}, &copied);
+    }
+
+    QVERIFY(copied.size() == filesCount);
+    QVERIFY(QFileInfo(target + "/module5/file5.qml").size() == data.size());
+
+    qint64 bytes = 0;
+    for (int i = 0; i < CopyBackend::BackendsCount; ++i) {
+        bytes += manager.copyBackend().bytes(static_cast<CopyBackend::Backend>(i));
+    }
+    QVERIFY(bytes >= filesCount * data.size());
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testIncrementalDeploy() {
+    const QString root = QFileInfo("./test/incremental").absoluteFilePath();
+    const QString target = root + "/target";
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root + "/source"));
+
+    auto write = [](const QString &file, const QByteArray &data) {
+        QFile f(file);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return false;
+        }
+
+        return f.write(data) == data.size();
+    };
+
+    const QString a = root + "/source/a.so";
+    const QString b = root + "/source/b.so";
+    const QString c = root + "/source/c.so";
+    QVERIFY(write(a, "aaaa"));
+    QVERIFY(write(b, "bbbb"));
+    QVERIFY(write(c, "cccc"));
+
+    auto copied = [](FileManager &manager) {
+        int result = 0;
+        for (int i = 0; i < CopyBackend::BackendsCount; ++i) {
+            result += manager.copyBackend().files(static_cast<CopyBackend::Backend>(i));
+        }
+        return result;
+    };
+
+    QuasarAppUtils::Params::parseParams(QStringList{"incremental"});
+
+    {
+        FileManager manager;
+        manager.loadDeployemendFiles(target);
+        QVERIFY(manager.copyFileList({a, b}, target));
+        QVERIFY(manager.copyFileList({c}, target + "/stale"));
+        QVERIFY(copied(manager) == 3);
+        QVERIFY(manager.manifest().size() == 3);
+        manager.saveDeploymendFiles(target);
+    }
+
+    // the b is changed and the c is not deployed any more.
+    QVERIFY(write(b, "bbbbbb"));
+
+    {
+        FileManager manager;
+        manager.loadDeployemendFiles(target);
+        QVERIFY(manager.copyFileList({a, b}, target));
+        QVERIFY(copied(manager) == 1);
+        QVERIFY(manager.removeStaleFiles() == 1);
+        manager.saveDeploymendFiles(target);
+    }
+
+    QVERIFY(QFileInfo(target + "/b.so").size() == 6);
+    QVERIFY(!QFileInfo::exists(target + "/stale/c.so"));
+
+    // the empty directories of the stale files are removed too.
+    QVERIFY(!QFileInfo::exists(target + "/stale"));
+
+    // the content of the a is changed, but the size and the modification time are same.
+    auto mtime = QFileInfo(a).lastModified();
+    QVERIFY(write(a, "AAAA"));
+    QFile source(a);
+    QVERIFY(source.open(QIODevice::ReadWrite));
+    QVERIFY(source.setFileTime(mtime, QFileDevice::FileModificationTime));
+    source.close();
+
+    {
+        FileManager manager;
+        manager.loadDeployemendFiles(target);
+        QVERIFY(manager.copyFileList({a, b}, target));
+        QVERIFY(copied(manager) == 0);
+    }
+
+    QuasarAppUtils::Params::parseParams(QStringList{"-incremental", "strict"});
+
+    {
+        FileManager manager;
+        manager.loadDeployemendFiles(target);
+        QVERIFY(manager.copyFileList({a, b}, target));
+        QVERIFY(copied(manager) == 2);
+        manager.saveDeploymendFiles(target);
+    }
+
+    {
+        FileManager manager;
+        manager.loadDeployemendFiles(target);
+        QVERIFY(manager.copyFileList({a, b}, target));
+        QVERIFY(copied(manager) == 0);
+    }
+
+    QFile result(target + "/a.so");
+    QVERIFY(result.open(QIODevice::ReadOnly));
+    QVERIFY(result.readAll() == "AAAA");
+    result.close();
+
+    QuasarAppUtils::Params::parseParams(QStringList{});
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testDeployManifest() {
+    const QString root = QFileInfo("./test/manifest").absoluteFilePath();
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root + "/lib"));
+
+    DeployManifest manifest;
+    for (int i = 0; i < 1000; ++i) {
+        DeployManifest::Entry entry;
+        entry.source = "/usr/lib/libTest" + QString::number(i) + ".so";
+        entry.sourceSize = i;
+        entry.sourceMtime = 1000000 + i;
+        entry.size = i;
+        entry.mtime = 2000000 + i;
+        if (i % 2) {
+            entry.hash = QCryptographicHash::hash(entry.source.toUtf8(), QCryptographicHash::Sha1);
+        }
+
+        manifest.insert(root + "/lib/libTest" + QString::number(i) + ".so", entry);
+    }
+    manifest.insert(root + "/lib", DeployManifest::createEntry(root + "/lib"));
+
+    const QString file = DeployManifest::path(root);
+    QVERIFY(manifest.save(file, root));
+
+    DeployManifest loaded;
+    QVERIFY(loaded.load(file, root));
+    QVERIFY(loaded.size() == manifest.size());
+
+    for (const auto &path : manifest.files()) {
+        QVERIFY(loaded.contains(path));
+        auto expected = manifest.value(path);
+        auto actual = loaded.value(path);
+        QVERIFY(actual.source == expected.source);
+        QVERIFY(actual.sourceSize == expected.sourceSize);
+        QVERIFY(actual.sourceMtime == expected.sourceMtime);
+        QVERIFY(actual.size == expected.size);
+        QVERIFY(actual.mtime == expected.mtime);
+        QVERIFY(actual.hash == expected.hash);
+    }
+
+    // the paths are saved relative to the target directory.
+    QVERIFY(QFile::rename(root, root + "_moved"));
+    QVERIFY(loaded.load(DeployManifest::path(root + "_moved"), root + "_moved"));
+    QVERIFY(loaded.contains(root + "_moved/lib/libTest1.so"));
+    QVERIFY(QFile::rename(root + "_moved", root));
+
+    // the damaged manifest is ignored.
+    QFile damaged(file);
+    QVERIFY(damaged.resize(damaged.size() - 1));
+    QVERIFY(!loaded.load(file, root));
+    QVERIFY(!loaded.size());
+
+    // the file manager reads the list of the deployed files from the manifest.
+    QVERIFY(manifest.save(file, root));
+    FileManager manager;
+    manager.loadDeployemendFiles(root);
+    QVERIFY(manager.getDeployedFiles().size() == manifest.size());
+
+    manager.clear(root, false);
+    QVERIFY(!QFileInfo::exists(file));
+    QVERIFY(!QFileInfo::exists(root + "/lib"));
+
+    // the list saved into the settings by the old versions is read once and removed after saving of the manifest.
+    QVERIFY(QDir().mkpath(root + "/lib"));
+    auto settings = QuasarAppUtils::Settings::get();
+    settings->setValue(root, QStringList{root + "/lib"});
+
+    FileManager oldManager;
+    oldManager.loadDeployemendFiles(root);
+    QVERIFY(oldManager.getDeployedFiles().contains(root + "/lib"));
+    oldManager.saveDeploymendFiles(root);
+    QVERIFY(QFileInfo::exists(file));
+    QVERIFY(settings->getValue(root, "").toStringList().isEmpty());
+
+    FileManager newManager;
+    newManager.loadDeployemendFiles(root);
+    QVERIFY(newManager.getDeployedFiles().contains(root + "/lib"));
+    QVERIFY(newManager.manifest().contains(root + "/lib"));
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testParallelClear() {
+    const QString root = QFileInfo("./test/parallelClear").absoluteFilePath();
+    const QString target = root + "/target";
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root + "/source"));
+
+    QStringList sources;
+    for (int i = 0; i < 100; ++i) {
+        QFile file(root + "/source/lib" + QString::number(i) + ".so");
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QVERIFY(file.write(QByteArray(100, 'x')) == 100);
+        sources.push_back(file.fileName());
+    }
+
+    FileManager manager;
+    QVERIFY(manager.initDir(target));
+    for (int i = 0; i < 20; ++i) {
+        const QString dir = target + "/dir" + QString::number(i);
+        QVERIFY(manager.initDir(dir));
+        QVERIFY(manager.copyFileList(sources, dir));
+    }
+
+    // the not deployed files and their directories should not be removed.
+    QFile foreign(target + "/dir0/foreign.txt");
+    QVERIFY(foreign.open(QIODevice::WriteOnly));
+    foreign.close();
+
+    auto result = manager.clear(target, false);
+    QVERIFY(result.files == 2000);
+    QVERIFY(result.bytes == 2000 * 100);
+    QVERIFY(result.dirs == 19);
+
+    QVERIFY(manager.getDeployedFiles().isEmpty());
+    QVERIFY(QFileInfo::exists(foreign.fileName()));
+    QVERIFY(!QFileInfo::exists(target + "/dir1"));
+    QVERIFY(QDir(target + "/dir0").entryList(QDir::NoDotAndDotDot | QDir::AllEntries).size() == 1);
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testStripDeployedFiles() {
+#ifdef Q_OS_UNIX
+    const QString root = QFileInfo("./test/stripStage").absoluteFilePath();
+    const QString target = root + "/target";
+    QDir(root).removeRecursively();
+
+    QStringList sources = {
+        root + "/source/debugLib1.so",
+        root + "/source/debugLib2.so.1.2",
+    };
+
+    QList<qint64> sizes;
+    for (const auto &lib: sources) {
+        sizes.push_back(generateLib(lib));
+    }
+
+    FileManager manager;
+    QVERIFY(manager.copyFileList(sources, target));
+
+    ELF elf;
+    QVERIFY(elf.isStrippable(target + "/debugLib1.so"));
+    QVERIFY(elf.isStrippable(target + "/debugLib2.so.1.2"));
+
+    QVERIFY(manager.stripDeployedFiles());
+
+    QVERIFY(QFileInfo(target + "/debugLib1.so").size() < sizes[0]);
+    QVERIFY(QFileInfo(target + "/debugLib2.so.1.2").size() < sizes[1]);
+    QVERIFY(!elf.isStrippable(target + "/debugLib1.so"));
+    QVERIFY(!elf.isStrippable(target + "/debugLib2.so.1.2"));
+
+    // the source files are not changed.
+    QVERIFY(elf.isStrippable(sources[0]));
+    QVERIFY(QFileInfo(sources[0]).size() == sizes[0]);
+
+    // the already stripped files are skipped.
+    QVERIFY(manager.copyFileList({target + "/debugLib1.so"}, root + "/target2"));
+    auto copied = QFileInfo(root + "/target2/debugLib1.so").lastModified();
+    QVERIFY(manager.stripDeployedFiles());
+    QVERIFY(QFileInfo(root + "/target2/debugLib1.so").lastModified() == copied);
+
+    // the not elf libraries are passed to the strip tool, it fails on the invalid library.
+    QFile notElf(root + "/source/notElf.dll");
+    QVERIFY(notElf.open(QIODevice::WriteOnly));
+    QVERIFY(notElf.write("not elf library") > 0);
+    notElf.close();
+
+    QVERIFY(!elf.isElf(notElf.fileName()));
+    QVERIFY(elf.isElf(sources[0]));
+    QVERIFY(manager.copyFileList({notElf.fileName()}, root + "/target3"));
+    QVERIFY(!manager.stripDeployedFiles());
+
+    QDir(root).removeRecursively();
+#endif
+}
+
+void deploytest::testElfReader() {
+    const QString root = QFileInfo("./test/elfReader").absoluteFilePath();
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root));
+
+    auto copyResource = [&root](const QString &resource, int size = -1) {
+        QFile source(resource);
+        if (!source.open(QIODevice::ReadOnly)) {
+            return QString();
+        }
+
+        QFile target(root + "/" + QString(resource).remove(":/") + ((size < 0)? "": "." + QString::number(size)));
+        if (!target.open(QIODevice::WriteOnly)) {
+            return QString();
+        }
+
+        target.write((size < 0)? source.readAll(): source.read(size));
+        return QFileInfo(target).absoluteFilePath();
+    };
+
+    ELF elf;
+    ElfDynamicInfo dynamic;
+
+    // the DT_RPATH of the library.
+    QString lib = copyResource(":/linux64.so");
+    QVERIFY(elf.readDynamic(lib, dynamic));
+    QVERIFY(dynamic.platform == Unix_x86_64);
+    QVERIFY(dynamic.needed == QByteArrayList({"libQt5Core.so.5", "libpthread.so.0", "libstdc++.so.6",
+                                              "libm.so.6", "libgcc_s.so.1", "libc.so.6"}));
+    QVERIFY(dynamic.soname == "libSignalProcessorCommon.so.1");
+    QVERIFY(dynamic.rpath == "/home/astra/Qt/5.9.6-smolensk-1.5/lib");
+    QVERIFY(dynamic.runpath.isEmpty());
+
+    // the DT_RUNPATH of the executable.
+    lib = copyResource(":/linux64");
+    QVERIFY(elf.readDynamic(lib, dynamic));
+    QVERIFY(dynamic.platform == Unix_x86_64);
+    QVERIFY(dynamic.needed == QByteArrayList({"libQuasarApp.so.1", "libServerProtocol.so.1", "libQt5Network.so.5",
+                                              "libQt5Core.so.5", "libstdc++.so.6", "libgcc_s.so.1", "libc.so.6"}));
+    QVERIFY(dynamic.soname.isEmpty());
+    QVERIFY(dynamic.rpath.isEmpty());
+    QVERIFY(dynamic.runpath == "/home/endrii/Qt/5.12.1/gcc_64/lib");
+
+    // the fixtures have the DT_RPATH "/usr" and the DT_RUNPATH "$ORIGIN/lib:/".
+    const QMap<QString, Platform> fixtures = {
+        {":/linux32.so", Unix_x86_32},
+        {":/linuxArm32.so", Unix_ARM_32},
+        {":/linuxArm32be.so", Unix_ARM_32},
+        {":/linuxArm64.so", Unix_ARM_64},
+        {":/linuxArm64be.so", Unix_ARM_64},
+    };
+
+    for (auto it = fixtures.begin(); it != fixtures.end(); ++it) {
+        lib = copyResource(it.key());
+        QVERIFY(elf.readDynamic(lib, dynamic));
+        QVERIFY(dynamic.platform == it.value());
+        QVERIFY(elf.getPlatform(lib) == it.value());
+        QVERIFY(dynamic.needed == QByteArrayList({"libfixturedep.so.1", "libfixtureother.so.2"}));
+        QVERIFY(dynamic.soname == "libfixture.so.1");
+        QVERIFY(dynamic.rpath == "/usr");
+        QVERIFY(dynamic.runpath == "$ORIGIN/lib:/");
+
+        // the DT_RUNPATH is used instead of the DT_RPATH and the $ORIGIN is skipped.
+        LibInfo info;
+        QVERIFY(elf.getLibInfo(lib, info));
+        QVERIFY(info.getPlatform() == it.value());
+        QVERIFY(info.getQtPath() == "/");
+        QVERIFY(info.getDependncies() == QSet<QString>({"libfixturedep.so.1", "libfixtureother.so.2"}));
+
+        // the truncated files are rejected.
+        QVector<ElfSection> sections;
+        QVERIFY(elf.readSections(lib, sections));
+        const bool is64 = it.value() == Unix_x86_64 || it.value() == Unix_ARM_64;
+        QList<int> sizes = {16, (is64)? 72: 60};
+        for (const auto &section: qAsConst(sections)) {
+            if (section.name == ".dynamic" || section.name == ".dynstr") {
+                sizes.push_back(static_cast<int>(section.offset + section.size / 2));
+            }
+        }
+        QVERIFY(sizes.size() == 4);
+
+        for (int size: qAsConst(sizes)) {
+            QVERIFY(!elf.readDynamic(copyResource(it.key(), size), dynamic));
+        }
+    }
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testPEReader() {
+    const QString root = QFileInfo("./test/peReader").absoluteFilePath();
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root));
+
+    struct Expected {
+        Platform platform;
+        QSet<QString> imports;
+    };
+
+    // the fixtures built by the lld have the import of the FIXTUREDEP.DLL and the delay import of the FIXTUREDELAYED.DLL.
+    const QMap<QString, Expected> binaries = {
+        {":/win32mingw.exe", {Win32, {"QT5CORE.DLL", "QT5GUI.DLL", "QT5QML.DLL", "QT5WIDGETS.DLL", "LIBGCC_S_DW2-1.DLL",
+                                      "KERNEL32.DLL", "MSVCRT.DLL", "SHELL32.DLL", "LIBSTDC++-6.DLL"}}},
+        {":/win32mingw.dll", {Win32, {"LIBGCC_S_DW2-1.DLL", "KERNEL32.DLL", "MSVCRT.DLL", "LIBGLESV2.DLL"}}},
+        {":/win32msvc.dll", {Win32, {"OLE32.DLL", "OLEAUT32.DLL", "WINMM.DLL", "QT5MULTIMEDIA.DLL", "QT5CORE.DLL",
+                                     "MSVCP120.DLL", "MSVCR120.DLL", "KERNEL32.DLL"}}},
+        {":/win32msvc.exe", {Win32, {"QT5CORE.DLL", "VIEWFORTIS.DLL", "POCKETPROTOCOLS.DLL", "MODELSFORTIS.DLL",
+                                     "COMMONBASE.DLL", "SERVICES.DLL", "SETTINGSMAIN.DLL", "COMMONUTILS.DLL",
+                                     "COMMONSERVICES.DLL", "PFDF_SERVICES.DLL", "DRONTESTCONTROLLERS.DLL",
+                                     "DRONTESTVIEW.DLL", "DRONTESTMODEL.DLL", "DRONTESTSETTINGS.DLL",
+                                     "DRONESPROFILES.DLL", "QT5WIDGETS.DLL", "QT5GUI.DLL", "MSVCP120.DLL",
+                                     "MSVCR120.DLL", "KERNEL32.DLL", "SHELL32.DLL"}}},
+        {":/win64mingw.exe", {Win64, {"DEPLOY.DLL", "QUASARAPP1.DLL", "QT5CORE.DLL", "LIBGCC_S_SEH-1.DLL",
+                                      "KERNEL32.DLL", "MSVCRT.DLL", "LIBSTDC++-6.DLL"}}},
+        {":/win64mingw.dll", {Win64, {"QUASARAPP1.DLL", "QT5CORE.DLL", "LIBGCC_S_SEH-1.DLL", "KERNEL32.DLL",
+                                      "MSVCRT.DLL", "SHLWAPI.DLL", "LIBSTDC++-6.DLL"}}},
+        {":/win64msvc.exe", {Win64, {"NETWORKSERVICEENGINE.DLL", "QTSERVICE.DLL", "QT5CORE.DLL", "KERNEL32.DLL",
+                                     "VCRUNTIME140.DLL", "API-MS-WIN-CRT-HEAP-L1-1-0.DLL",
+                                     "API-MS-WIN-CRT-RUNTIME-L1-1-0.DLL", "API-MS-WIN-CRT-MATH-L1-1-0.DLL",
+                                     "API-MS-WIN-CRT-STDIO-L1-1-0.DLL", "API-MS-WIN-CRT-LOCALE-L1-1-0.DLL"}}},
+        {":/win64msvc.dll", {Win64, {"QT5CORE.DLL", "MSVCP140.DLL", "KERNEL32.DLL", "VCRUNTIME140.DLL",
+                                     "API-MS-WIN-CRT-RUNTIME-L1-1-0.DLL", "API-MS-WIN-CRT-HEAP-L1-1-0.DLL"}}},
+        {":/win32delay.dll", {Win32, {"FIXTUREDEP.DLL", "FIXTUREDELAYED.DLL"}}},
+        {":/win64delay.dll", {Win64, {"FIXTUREDEP.DLL", "FIXTUREDELAYED.DLL"}}},
+        {":/winArm64delay.dll", {win_ARM_64, {"FIXTUREDEP.DLL", "FIXTUREDELAYED.DLL"}}},
+    };
+
+    PE pe;
+
+    for (auto it = binaries.begin(); it != binaries.end(); ++it) {
+        const QString file = root + "/" + QString(it.key()).remove(":/");
+        QVERIFY(QFile::copy(it.key(), file));
+
+        // the machine and the magic of the optional header.
+        QVERIFY2(pe.getPlatform(file) == it->platform, file.toLatin1());
+
+        // the import and the delay import directories.
+        LibInfo info;
+        QVERIFY2(pe.getLibInfo(file, info), file.toLatin1());
+        QVERIFY(info.getPlatform() == it->platform);
+        QVERIFY2(info.getDependncies() == it->imports, file.toLatin1());
+    }
+
+    // the elf files are not pe files.
+    const QString elf = root + "/linux64.so";
+    QVERIFY(QFile::copy(":/linux64.so", elf));
+    LibInfo info;
+    QVERIFY(pe.getPlatform(elf) == UnknownPlatform);
+    QVERIFY(!pe.getLibInfo(elf, info));
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testElfStrip() {
+    // the libraries of all supported elf platforms are stripped by the ELF::strip without the strip tool.
+    {
+        const QString root = QFileInfo("./test/elfStrip/platforms").absoluteFilePath();
+        QDir(root).removeRecursively();
+        QVERIFY(QDir().mkpath(root));
+
+        const QStringList fixtures = {
+            ":/linux32.so",
+            ":/linuxArm32.so",
+            ":/linuxArm32be.so",
+            ":/linuxArm64.so",
+            ":/linuxArm64be.so",
+        };
+
+        ELF elf;
+
+        for (const auto &fixture: fixtures) {
+            const QString lib = root + "/" + QString(fixture).remove(":/");
+            const QString splited = lib + ".splited";
+            const QString debug = splited + ".debug";
+            QVERIFY(QFile::copy(fixture, lib));
+            QVERIFY(QFile::copy(fixture, splited));
+            QVERIFY(QFile::setPermissions(lib, QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner));
+            QVERIFY(QFile::setPermissions(splited, QFile::ReadOwner | QFile::WriteOwner));
+
+            ElfDynamicInfo originalDynamic;
+            QVector<ElfSection> originalSections;
+            QVERIFY(elf.readDynamic(lib, originalDynamic));
+            QVERIFY(elf.readSections(lib, originalSections));
+            QVERIFY(elf.isStrippable(lib));
+
+            QFile originalFile(lib);
+            QVERIFY(originalFile.open(QIODevice::ReadOnly));
+            const QByteArray originalData = originalFile.readAll();
+            originalFile.close();
+
+            QVERIFY(elf.strip(lib) == ELF::StripDone);
+            QVERIFY(elf.splitDebug(splited, debug) == ELF::StripDone);
+            QVERIFY(QFile::permissions(lib) & QFile::ExeOwner);
+            QVERIFY(!(QFile::permissions(splited) & QFile::ExeOwner));
+
+            for (const auto &file: {lib, splited}) {
+                QVERIFY(!elf.isStrippable(file));
+                QVERIFY(QFileInfo(file).size() < originalData.size());
+
+                // the dynamic section is read in same way from the stripped file.
+                ElfDynamicInfo dynamic;
+                QVERIFY(elf.readDynamic(file, dynamic));
+                QVERIFY(dynamic.platform == originalDynamic.platform);
+                QVERIFY(dynamic.needed == originalDynamic.needed);
+                QVERIFY(dynamic.soname == originalDynamic.soname);
+                QVERIFY(dynamic.rpath == originalDynamic.rpath);
+                QVERIFY(dynamic.runpath == originalDynamic.runpath);
+
+                // the loaded sections are not moved.
+                QVector<ElfSection> sections;
+                QVERIFY(elf.readSections(file, sections));
+
+                QFile strippedFile(file);
+                QVERIFY(strippedFile.open(QIODevice::ReadOnly));
+                const QByteArray strippedData = strippedFile.readAll();
+
+                for (const auto &section: qAsConst(sections)) {
+                    QVERIFY(!section.name.startsWith(".debug") && section.name != ".symtab");
+                    if (!(section.flags & 0x2) || section.type == 8) {
+                        continue;
+                    }
+
+                    auto source = std::find_if(originalSections.begin(), originalSections.end(), [&section](const ElfSection &item) {
+                        return item.name == section.name;
+                    });
+
+                    QVERIFY(source != originalSections.end());
+                    QVERIFY(source->offset == section.offset);
+                    QVERIFY(originalData.mid(static_cast<int>(source->offset), static_cast<int>(source->size)) ==
+                            strippedData.mid(static_cast<int>(section.offset), static_cast<int>(section.size)));
+                }
+            }
+
+            // the debug file keeps the byte order and the debug sections of the library.
+            QVERIFY(elf.getPlatform(debug) == originalDynamic.platform);
+            QVERIFY(elf.isStrippable(debug));
+            QVector<ElfSection> debugSections;
+            QVERIFY(elf.readSections(debug, debugSections));
+            QVERIFY(std::any_of(debugSections.begin(), debugSections.end(), [](const ElfSection &section) {
+                return section.name == ".debug_info" && section.size;
+            }));
+        }
+
+        // the temporary files of the strip are not left near the libraries.
+        QVERIFY(QDir(root).entryList(QDir::Files).size() == fixtures.size() * 3);
+
+        QDir(root).removeRecursively();
+    }
+
+#ifdef Q_OS_UNIX
+    const QString stripTool = QStandardPaths::findExecutable("strip");
+    if (stripTool.isEmpty()) {
+        QSKIP("The strip tool is not found");
+    }
+
+    const QString root = QFileInfo("./test/elfStrip").absoluteFilePath();
+    QDir(root).removeRecursively();
+
+    const QString original = root + "/original.so";
+    const QString internal = root + "/internal.so";
+    const QString external = root + "/external.so";
+    generateLib(original);
+    QVERIFY(QFile::copy(original, internal));
+    QVERIFY(QFile::copy(original, external));
+    QVERIFY(QFile::setPermissions(internal, QFile::permissions(original) | QFile::ExeOwner));
+
+    QVERIFY(QProcess::execute(stripTool, {"--strip-unneeded", external}) == 0);
+
+    ELF elf;
+    QVERIFY(elf.strip(internal) == ELF::StripDone);
+    QVERIFY(!elf.isStrippable(internal));
+    QVERIFY(QFile::permissions(internal) & QFile::ExeOwner);
+
+    QVector<ElfSection> originalSections, internalSections, externalSections;
+    QVERIFY(elf.readSections(original, originalSections));
+    QVERIFY(elf.readSections(internal, internalSections));
+    QVERIFY(elf.readSections(external, externalSections));
+
+    // the result contains same sections as result of the strip tool.
+    QVERIFY(internalSections.size() == externalSections.size());
+    for (int i = 0; i < internalSections.size(); ++i) {
+        QVERIFY(internalSections[i].name == externalSections[i].name);
+        QVERIFY(internalSections[i].type == externalSections[i].type);
+        QVERIFY(internalSections[i].size == externalSections[i].size ||
+                internalSections[i].name == ".shstrtab");
+    }
+
+    // the size of the result differs only by alignment and the section names table.
+    QVERIFY(qAbs(QFileInfo(internal).size() - QFileInfo(external).size()) < 256);
+
+    // the loaded sections are not moved.
+    QFile originalFile(original);
+    QFile internalFile(internal);
+    QVERIFY(originalFile.open(QIODevice::ReadOnly));
+    QVERIFY(internalFile.open(QIODevice::ReadOnly));
+    const QByteArray originalData = originalFile.readAll();
+    const QByteArray internalData = internalFile.readAll();
+
+    for (const auto &section: qAsConst(internalSections)) {
+        if (!(section.flags & 0x2) || section.type == 8) {
+            continue;
+        }
+
+        auto source = std::find_if(originalSections.begin(), originalSections.end(), [&section](const ElfSection &item) {
+            return item.name == section.name;
+        });
+
+        QVERIFY(source != originalSections.end());
+        QVERIFY(source->offset == section.offset);
+        QVERIFY(originalData.mid(static_cast<int>(source->offset), static_cast<int>(source->size)) ==
+                internalData.mid(static_cast<int>(section.offset), static_cast<int>(section.size)));
+    }
+
+    // the stripped file is not changed again.
+    QVERIFY(elf.strip(internal) == ELF::StripDone);
+    QVERIFY(QFileInfo(internal).size() == internalData.size());
+
+    // not elf files are not changed.
+    QFile text(root + "/text.so");
+    QVERIFY(text.open(QIODevice::WriteOnly));
+    QVERIFY(text.write("not elf file") > 0);
+    text.close();
+    QVERIFY(elf.strip(text.fileName()) == ELF::StripNotSupported);
+    QVERIFY(QFileInfo(text.fileName()).size() == 12);
+
+    QDir(root).removeRecursively();
+#endif
+}
+
+void deploytest::testSplitDebug() {
+#ifdef Q_OS_UNIX
+    const QString root = QFileInfo("./test/splitDebug").absoluteFilePath();
+    const QString target = root + "/target";
+    QDir(root).removeRecursively();
+
+    const QString source = root + "/source/debugLib.so";
+    const qint64 size = generateLib(source);
+
+    FileManager manager;
+    QVERIFY(manager.copyFileList({source}, target + "/Application/lib"));
+    QVERIFY(manager.stripDeployedFiles(target, target + "/ApplicationDebug"));
+
+    const QString lib = target + "/Application/lib/debugLib.so";
+    const QString debug = target + "/ApplicationDebug/Application/lib/debugLib.so.debug";
+
+    ELF elf;
+    QVERIFY(QFileInfo(lib).size() < size);
+    QVERIFY(!elf.isStrippable(lib));
+    QVERIFY(elf.isStrippable(debug));
+    QVERIFY(manager.getDeployedFiles().contains(debug));
+
+    // the stripped library is linked with the debug file.
+    QVector<ElfSection> sections;
+    QVERIFY(elf.readSections(lib, sections));
+    auto link = std::find_if(sections.begin(), sections.end(), [](const ElfSection &section) {
+        return section.name == ".gnu_debuglink";
+    });
+    QVERIFY(link != sections.end());
+
+    QFile libFile(lib);
+    QVERIFY(libFile.open(QIODevice::ReadOnly));
+    QVERIFY(libFile.seek(static_cast<qint64>(link->offset)));
+    QVERIFY(libFile.read(static_cast<qint64>(link->size)).startsWith("debugLib.so.debug"));
+    libFile.close();
+
+    // the debug file contains the debug sections and does not contain the code.
+    QVERIFY(elf.readSections(debug, sections));
+    QVERIFY(std::any_of(sections.begin(), sections.end(), [](const ElfSection &section) {
+        return section.name == ".debug_info" && section.size;
+    }));
+    QVERIFY(std::all_of(sections.begin(), sections.end(), [](const ElfSection &section) {
+        return section.name != ".text" || section.type == 8;
+    }));
+    QVERIFY(QFileInfo(debug).size() < size);
+
+    // the incremental deploy keeps the debug files of the unchanged libraries.
+    QDir(root).removeRecursively();
+    generateLib(source);
+    QuasarAppUtils::Params::parseParams(QStringList{"-incremental", "-splitDebug"});
+
+    QDateTime stripped;
+    for (int i = 0; i < 2; ++i) {
+        FileManager incremental;
+        incremental.loadDeployemendFiles(target);
+        QVERIFY(incremental.copyFileList({source}, target + "/Application/lib"));
+        QVERIFY(incremental.stripDeployedFiles(target, target + "/ApplicationDebug"));
+        QVERIFY(incremental.getDeployedFiles().contains(debug));
+        QVERIFY(incremental.removeStaleFiles() == 0);
+        incremental.saveDeploymendFiles(target);
+
+        QVERIFY(!elf.isStrippable(lib));
+        QVERIFY(elf.isStrippable(debug));
+
+        // the library is not copied and stripped again.
+        QVERIFY(!i || QFileInfo(lib).lastModified() == stripped);
+        stripped = QFileInfo(lib).lastModified();
+    }
+
+    QuasarAppUtils::Params::parseParams(QStringList{});
+    QDir(root).removeRecursively();
+#endif
+}
+
+void deploytest::testMoveFolder() {
+    const QString root = QFileInfo("./test/moveFolder").absoluteFilePath();
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root + "/source"));
+
+    QStringList sources;
+    for (int i = 0; i < 50; ++i) {
+        QFile file(root + "/source/file" + QString::number(i) + ".txt");
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QVERIFY(file.write(QByteArray::number(i)) > 0);
+        sources.push_back(file.fileName());
+    }
+
+    FileManager manager;
+    QVERIFY(manager.copyFileList(sources, root + "/package/data"));
+    QVERIFY(manager.copyFileList(sources.mid(0, 10), root + "/package/data/sub"));
+    QVERIFY(manager.initDir(root + "/package/empty"));
+
+    auto checkDeployed = [&manager](const QString &from, const QString &to) {
+        const auto deployed = manager.getDeployedFiles();
+        for (const auto &path: deployed) {
+            if (path.startsWith(from + "/")) {
+                return false;
+            }
+        }
+
+        return deployed.contains(to + "/data/file0.txt") &&
+                deployed.contains(to + "/data/sub/file9.txt") &&
+                deployed.contains(to + "/empty");
+    };
+
+    // the package is moved with one rename.
+    QVERIFY(manager.moveFolder(root + "/package", root + "/tmp_data/package"));
+    QVERIFY(!QFileInfo::exists(root + "/package"));
+    QVERIFY(QFileInfo::exists(root + "/tmp_data/package/data/file49.txt"));
+    QVERIFY(QFileInfo::exists(root + "/tmp_data/package/data/sub/file9.txt"));
+    QVERIFY(QFileInfo(root + "/tmp_data/package/empty").isDir());
+    QVERIFY(checkDeployed(root + "/package", root + "/tmp_data/package"));
+
+    // the target is not empty, so files are moved one by one.
+    QVERIFY(QDir().mkpath(root + "/package"));
+    QFile existing(root + "/package/existing.txt");
+    QVERIFY(existing.open(QIODevice::WriteOnly));
+    existing.close();
+
+    QVERIFY(manager.moveFolder(root + "/tmp_data/package", root + "/package"));
+    QVERIFY(QDir(root + "/tmp_data/package").removeRecursively());
+    QVERIFY(QFileInfo::exists(root + "/package/existing.txt"));
+    QVERIFY(QFileInfo::exists(root + "/package/data/file49.txt"));
+    QVERIFY(QFileInfo::exists(root + "/package/data/sub/file9.txt"));
+    QVERIFY(QFileInfo(root + "/package/empty").isDir());
+    QVERIFY(checkDeployed(root + "/tmp_data/package", root + "/package"));
+
+    // the ignored files are not moved.
+    QVERIFY(manager.moveFolder(root + "/package", root + "/moved", "file1"));
+    QVERIFY(QFileInfo::exists(root + "/package/data/file1.txt"));
+    QVERIFY(!QFileInfo::exists(root + "/moved/data/file1.txt"));
+    QVERIFY(QFileInfo::exists(root + "/moved/data/file2.txt"));
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testLinkFolder() {
+    const QString root = QFileInfo("./test/linkFolder").absoluteFilePath();
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root + "/tmp_data/package/data/sub"));
+    QVERIFY(QDir().mkpath(root + "/tmp_data/package/empty"));
+
+    auto writeFile = [](const QString &path, const QByteArray &data) {
+        QFile file(path);
+        return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+    };
+
+    auto readFile = [](const QString &path) {
+        QFile file(path);
+        return file.open(QIODevice::ReadOnly)? file.readAll(): QByteArray();
+    };
+
+    for (int i = 0; i < 20; ++i) {
+        QVERIFY(writeFile(root + "/tmp_data/package/data/file" + QString::number(i) + ".txt", QByteArray::number(i)));
+    }
+    QVERIFY(writeFile(root + "/tmp_data/package/data/sub/file.txt", "sub"));
+
+    FileManager manager;
+
+    // every distribution gets own view of the same staged package.
+    QVERIFY(manager.linkFolder(root + "/tmp_data/package", root + "/zip/package"));
+    QVERIFY(QDir().mkpath(root + "/deb/package/opt/data"));
+    QVERIFY(writeFile(root + "/deb/package/opt/data/file0.txt", "template"));
+    QVERIFY(writeFile(root + "/deb/package/DEBIAN", "control"));
+    QVERIFY(manager.linkFolder(root + "/tmp_data/package", root + "/deb/package/opt"));
+
+    for (const auto &view: {root + "/zip/package", root + "/deb/package/opt"}) {
+        QCOMPARE(readFile(view + "/data/file19.txt"), QByteArray("19"));
+        QCOMPARE(readFile(view + "/data/sub/file.txt"), QByteArray("sub"));
+        QVERIFY(QFileInfo(view + "/empty").isDir());
+    }
+
+    // the existing files of the template are replaced by the package files, other files are not changed.
+    QCOMPARE(readFile(root + "/deb/package/opt/data/file0.txt"), QByteArray("0"));
+    QCOMPARE(readFile(root + "/deb/package/DEBIAN"), QByteArray("control"));
+
+    // the views are not deployed files and the source is not changed after removing of the views.
+    QVERIFY(manager.getDeployedFiles().isEmpty());
+    QVERIFY(QDir(root + "/zip").removeRecursively());
+    QVERIFY(QDir(root + "/deb").removeRecursively());
+    QCOMPARE(readFile(root + "/tmp_data/package/data/file19.txt"), QByteArray("19"));
+    QCOMPARE(readFile(root + "/tmp_data/package/data/sub/file.txt"), QByteArray("sub"));
+
+    // the view can not be created inside the source.
+    QVERIFY(!manager.linkFolder(root + "/tmp_data/package", root + "/tmp_data/package/view"));
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testPackingCommands() {
+    DeployConfig config;
+    config.jobs = 4;
+    ConfigGuard guard(&config);
+
+    const int count = 8;
+    QVector<QAtomicInt> visits(count);
+    QVector<QAtomicInt> threads(count);
+    QAtomicInt *visitsData = visits.data();
+    QAtomicInt *threadsData = threads.data();
+
+    // every third job fails, the failed jobs do not stop other jobs.
+    QList<SystemCommandData> commands;
+    for (int i = 0; i < count; ++i) {
+        SystemCommandData cmd;
+        cmd.command = "job";
+        cmd.arguments = QStringList{QString::number(i)};
+        cmd.function = [i, visitsData, threadsData](int jobs) {
+            visitsData[i].fetchAndAddOrdered(1);
+            threadsData[i].storeRelease(jobs);
+            return i % 3 != 0;
+        };
+        commands.push_back(cmd);
+    }
+
+    // the not exists program is failed job too.
+    SystemCommandData missing;
+    missing.command = QFileInfo("./test/packingCommands/notExistsProgram").absoluteFilePath();
+    commands.push_back(missing);
+
+    QVERIFY(Packing::runCommands(commands, QDir::currentPath()) == 4);
+
+    for (int i = 0; i < count; ++i) {
+        QVERIFY(visits[i].loadAcquire() == 1);
+
+        // the threads of the jobs option are shared between the running jobs.
+        QVERIFY(threads[i].loadAcquire() == 1);
+    }
+
+    // the single job uses all threads.
+    commands = {commands.first()};
+    QVERIFY(Packing::runCommands(commands, QDir::currentPath()) == 1);
+    QVERIFY(visits[0].loadAcquire() == 2);
+    QVERIFY(threads[0].loadAcquire() == config.jobs);
+
+    // the successful jobs.
+    commands = {};
+    for (int i = 1; i < 3; ++i) {
+        SystemCommandData cmd;
+        cmd.command = "job";
+        cmd.function = [i, visitsData, threadsData](int jobs) {
+            visitsData[i].fetchAndAddOrdered(1);
+            threadsData[i].storeRelease(jobs);
+            return true;
+        };
+        commands.push_back(cmd);
+    }
+
+    QVERIFY(Packing::runCommands(commands, QDir::currentPath()) == 0);
+    QVERIFY(visits[1].loadAcquire() == 2);
+    QVERIFY(visits[2].loadAcquire() == 2);
+    QVERIFY(threads[1].loadAcquire() == config.jobs / 2);
+}
+
 void deploytest::testQmlScaner() {
 
     // qt5
@@ -1421,6 +3100,97 @@ void deploytest::testZip() {
 
 }
 
+void deploytest::testZipLargeEntry() {
+    const QString root = QFileInfo("./test/zipLargeEntry").absoluteFilePath();
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root + "/source/data"));
+
+    // the entry is bigger than the read buffer and the last chunk is not full.
+    QByteArray data;
+    data.reserve(5 * 1024 * 1024 / 2);
+    quint32 seed = 1;
+    while (data.size() < 5 * 1024 * 1024 / 2) {
+        seed = seed * 1103515245 + 12345;
+        data.append(static_cast<char>(seed >> 16));
+    }
+
+    QFile large(root + "/source/data/large.bin");
+    QVERIFY(large.open(QIODevice::WriteOnly));
+    QCOMPARE(large.write(data), static_cast<qint64>(data.size()));
+    large.close();
+
+    QFile empty(root + "/source/data/empty.bin");
+    QVERIFY(empty.open(QIODevice::WriteOnly));
+    empty.close();
+
+    ZipCompresser zip;
+    QVERIFY(zip.compress(root + "/source", root + "/arr.zip"));
+    QVERIFY(zip.extract(root + "/arr.zip", root + "/result"));
+
+    QFile result(root + "/result/data/large.bin");
+    QVERIFY(result.open(QIODevice::ReadOnly));
+    QVERIFY(result.readAll() == data);
+    QCOMPARE(QFileInfo(root + "/result/data/empty.bin").size(), 0);
+
+    QDir(root).removeRecursively();
+}
+
+void deploytest::testZipWriter() {
+    QCOMPARE(ZipWriter::crc32Combine(0xCBF53A1Cu, 0x9DBABF87u, 4), 0xCBF43926u);
+
+    const QString root = QFileInfo("./test/zipWriter").absoluteFilePath();
+    QDir(root).removeRecursively();
+    QVERIFY(QDir().mkpath(root + "/source/lib/sub"));
+
+    // the big file is compressed by several jobs.
+    QByteArray large;
+    quint32 seed = 7;
+    while (large.size() < 3 * ZipWriter::ChunkSize + 100) {
+        seed = seed * 1103515245 + 12345;
+        large.append(static_cast<char>((seed >> 16) % 16));
+    }
+
+    QHash<QString, QByteArray> files = {
+        {"lib/large.bin", large},
+        {"lib/sub/text.txt", QByteArray("text").repeated(1000)},
+        {"empty.txt", QByteArray()},
+        {"run.sh", QByteArray("#!/bin/sh")}
+    };
+
+    for (auto it = files.cbegin(); it != files.cend(); ++it) {
+        QFile file(root + "/source/" + it.key());
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write(it.value()), static_cast<qint64>(it.value().size()));
+    }
+
+    QVERIFY(ZipWriter(9, 4).write(root + "/source", root + "/parallel.zip"));
+    QVERIFY(ZipWriter(9, 1).write(root + "/source", root + "/single.zip"));
+
+    // the result does not depend on count of the jobs.
+    QFile parallel(root + "/parallel.zip");
+    QFile single(root + "/single.zip");
+    QVERIFY(parallel.open(QIODevice::ReadOnly));
+    QVERIFY(single.open(QIODevice::ReadOnly));
+    QVERIFY(parallel.readAll() == single.readAll());
+
+    // the stored level is bigger than the compressed one.
+    QVERIFY(ZipWriter(0, 4).write(root + "/source", root + "/stored.zip"));
+    QVERIFY(QFileInfo(root + "/stored.zip").size() > QFileInfo(root + "/parallel.zip").size());
+
+    ZipCompresser zip;
+    for (const QString &arhive: {"parallel", "stored"}) {
+        QVERIFY(zip.extract(root + "/" + arhive + ".zip", root + "/" + arhive));
+
+        for (auto it = files.cbegin(); it != files.cend(); ++it) {
+            QFile file(root + "/" + arhive + "/" + it.key());
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            QVERIFY(file.readAll() == it.value());
+        }
+    }
+
+    QDir(root).removeRecursively();
+}
+
 void deploytest::runTestParams(QStringList list,
                                QSet<QString>* tree,
                                bool noWarnings, bool onlySize,